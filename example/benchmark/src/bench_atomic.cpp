@@ -0,0 +1,86 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    bench_atomic.cpp
+ * @brief   Benchmark of the atomic.h implementations (lock-free vs. interrupt masking)
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "benchmark.h"
+#include "atomic.h"
+
+
+namespace {
+/* reference implementations using the interrupt masking scheme of atomic.h (configUSE_GCC_BUILTIN_ATOMICS == 0) */
+__attribute__((noinline)) uint32_t masked_add(volatile uint32_t* p_addend, uint32_t count) {
+    const UBaseType_t mask { portSET_INTERRUPT_MASK_FROM_ISR() };
+    const uint32_t current { *p_addend };
+    *p_addend = current + count;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return current;
+}
+
+__attribute__((noinline)) uint32_t masked_or(volatile uint32_t* p_dest, uint32_t value) {
+    const UBaseType_t mask { portSET_INTERRUPT_MASK_FROM_ISR() };
+    const uint32_t current { *p_dest };
+    *p_dest = current | value;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return current;
+}
+
+__attribute__((noinline)) uint32_t masked_cas(volatile uint32_t* p_dest, uint32_t exchange, uint32_t comparand) {
+    uint32_t ret { ATOMIC_COMPARE_AND_SWAP_FAILURE };
+    const UBaseType_t mask { portSET_INTERRUPT_MASK_FROM_ISR() };
+    if (*p_dest == comparand) {
+        *p_dest = exchange;
+        ret = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+__attribute__((noinline)) uint32_t atomic_add(volatile uint32_t* p_addend, uint32_t count) {
+    return Atomic_Add_u32(p_addend, count);
+}
+
+__attribute__((noinline)) uint32_t atomic_or(volatile uint32_t* p_dest, uint32_t value) {
+    return Atomic_OR_u32(p_dest, value);
+}
+
+__attribute__((noinline)) uint32_t atomic_cas(volatile uint32_t* p_dest, uint32_t exchange, uint32_t comparand) {
+    return Atomic_CompareAndSwap_u32(p_dest, exchange, comparand);
+}
+
+volatile uint32_t g_value;
+} // namespace
+
+namespace benchmark {
+void atomic() {
+    ::Serial.printf(PSTR("atomic.h (configUSE_GCC_BUILTIN_ATOMICS=%d):\r\n"), configUSE_GCC_BUILTIN_ATOMICS);
+
+    print_result(PSTR("  masked add"), measure([]() { masked_add(&g_value, 1); }));
+    print_result(PSTR("  Atomic_Add_u32"), measure([]() { atomic_add(&g_value, 1); }));
+    print_result(PSTR("  masked or"), measure([]() { masked_or(&g_value, 1); }));
+    print_result(PSTR("  Atomic_OR_u32"), measure([]() { atomic_or(&g_value, 1); }));
+    print_result(PSTR("  masked cas"), measure([]() { masked_cas(&g_value, g_value + 1, g_value); }));
+    print_result(PSTR("  Atomic_CompareAndSwap_u32"), measure([]() { atomic_cas(&g_value, g_value + 1, g_value); }));
+    ::Serial.println();
+}
+} // namespace benchmark
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    bench_channel.cpp
+ * @brief   Benchmark of rendezvous channels compared to queues
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "benchmark.h"
+#include "semphr.h"
+#include "channel.h"
+
+#include <array>
+
+
+namespace {
+using item_t = std::array<uint8_t, 64>;
+
+ChannelHandle_t g_request;
+ChannelHandle_t g_response;
+QueueHandle_t g_queue;
+SemaphoreHandle_t g_done;
+
+/* same priority as the benchmark task, so both sides block in turn */
+void echo_task(void*) {
+    item_t item;
+    while (true) {
+        ::xChannelReceive(g_request, &item, portMAX_DELAY);
+        ::xChannelSend(g_response, &item, portMAX_DELAY);
+    }
+}
+
+/* the usual pattern for a synchronous transfer without channels: a queue plus a semaphore to signal completion */
+void queue_task(void*) {
+    item_t item;
+    while (true) {
+        ::xQueueReceive(g_queue, &item, portMAX_DELAY);
+        ::xSemaphoreGive(g_done);
+    }
+}
+} // namespace
+
+namespace benchmark {
+void channel() {
+    ::Serial.printf(PSTR("channel (configUSE_CHANNELS=%d):\r\n"), configUSE_CHANNELS);
+
+    g_request = ::xChannelCreate(sizeof(item_t));
+    g_response = ::xChannelCreate(sizeof(item_t));
+    g_queue = ::xQueueCreate(1, sizeof(item_t));
+    g_done = ::xSemaphoreCreateBinary();
+    TaskHandle_t echo, sync;
+    ::xTaskCreate(echo_task, "echo", 256, nullptr, ::uxTaskPriorityGet(nullptr), &echo);
+    ::xTaskCreate(queue_task, "sync", 256, nullptr, ::uxTaskPriorityGet(nullptr), &sync);
+
+    item_t item {};
+    print_result(PSTR("  64 byte channel send/receive"), measure([&item]() {
+        ::xChannelSend(g_request, &item, portMAX_DELAY);
+        ::xChannelReceive(g_response, &item, portMAX_DELAY);
+    }));
+    print_result(PSTR("  64 byte queue + semaphore"), measure([&item]() {
+        ::xQueueSend(g_queue, &item, portMAX_DELAY);
+        ::xSemaphoreTake(g_done, portMAX_DELAY);
+    }));
+
+    ::vTaskDelete(sync);
+    ::vTaskDelete(echo);
+    ::vSemaphoreDelete(g_done);
+    ::vQueueDelete(g_queue);
+    ::vChannelDelete(g_response);
+    ::vChannelDelete(g_request);
+    ::Serial.println();
+}
+} // namespace benchmark
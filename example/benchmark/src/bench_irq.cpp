@@ -0,0 +1,58 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    bench_irq.cpp
+ * @brief   Benchmark of threaded interrupt handlers
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "benchmark.h"
+
+
+namespace {
+TaskHandle_t g_bench_task;
+
+void handler(void*) {
+    ::xTaskNotifyGive(g_bench_task);
+}
+} // namespace
+
+namespace benchmark {
+void irq() {
+    ::Serial.printf(PSTR("threaded irq:\r\n"));
+
+    g_bench_task = ::xTaskGetCurrentTaskHandle();
+    /* the handler task runs above the benchmark task, so the measured time is interrupt entry, top half, switch to the handler task and back */
+    freertos::request_threaded_irq(IRQ_SOFTWARE, handler, nullptr, ::uxTaskPriorityGet(nullptr) + 1, PSTR("irq_bench"));
+
+    print_result(PSTR("  software irq round trip"), measure([]() {
+        NVIC_SET_PENDING(IRQ_SOFTWARE);
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }));
+
+    freertos::threaded_irq_stats stats;
+    freertos::get_threaded_irq_stats(IRQ_SOFTWARE, stats);
+    print_result(PSTR("  latency to handler (max)"), stats.max_latency);
+    print_result(PSTR("  handler runtime (avg)"), static_cast<uint32_t>(stats.total_runtime / stats.count));
+
+    freertos::free_threaded_irq(IRQ_SOFTWARE);
+    ::Serial.println();
+}
+} // namespace benchmark
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    bench_memcpy.cpp
+ * @brief   Benchmark of memory copy bandwidth per memory region
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#include "benchmark.h"
+#include "portable/memcpy_m7.h"
+
+#include <cstring>
+
+
+#if defined __IMXRT1062__
+extern "C" uint8_t external_psram_size;
+
+namespace {
+static constexpr size_t BLOCK_SIZE { 8'192 };
+static constexpr uint32_t REPEAT { 200 };
+static constexpr size_t SIZES[] { 64, 1'024, BLOCK_SIZE };
+
+uint8_t g_dtcm[2][BLOCK_SIZE] __attribute__((aligned(32)));
+DMAMEM uint8_t g_ocram[2][BLOCK_SIZE] __attribute__((aligned(32)));
+EXTMEM uint8_t g_psram[2][BLOCK_SIZE] __attribute__((aligned(32)));
+
+/* MB/s for REPEAT copies of size byte */
+template <typename F>
+uint32_t bandwidth(F&& func, const size_t size) {
+    const uint32_t start { ARM_DWT_CYCCNT };
+    for (uint32_t i {}; i < REPEAT; ++i) {
+        func();
+    }
+    const uint32_t cycles { ARM_DWT_CYCCNT - start };
+
+    return static_cast<uint32_t>(static_cast<uint64_t>(size) * REPEAT * (F_CPU_ACTUAL / 1'000'000UL) / cycles);
+}
+
+void run(const char* name, uint8_t* dst, uint8_t* src) {
+    ::Serial.printf(PSTR("  %s (MB/s):\r\n"), name);
+    for (const size_t size : SIZES) {
+        const uint32_t newlib { bandwidth([dst, src, size]() { std::memcpy(dst, src + 1, size - 1); }, size - 1) };
+        const uint32_t port { bandwidth([dst, src, size]() { ::pvPortMemcpy(dst, src + 1, size - 1); }, size - 1) };
+        const uint32_t port_aligned { bandwidth([dst, src, size]() { ::pvPortMemcpy(dst, src, size); }, size) };
+        const uint32_t dma { bandwidth([dst, src, size]() { freertos::copy(dst, src, size); }, size) };
+        ::Serial.printf(PSTR("    %5u byte: memcpy %5" PRIu32 "  pvPortMemcpy %5" PRIu32 " (aligned %5" PRIu32 ")  copy %5" PRIu32 "\r\n"), size, newlib, port, port_aligned, dma);
+    }
+}
+} // namespace
+
+namespace benchmark {
+void memory() {
+    ::Serial.println(PSTR("memory copy bandwidth (unaligned source for memcpy and pvPortMemcpy):"));
+
+    freertos::setup_dma_copy();
+    run(PSTR("DTCM"), g_dtcm[0], g_dtcm[1]);
+    run(PSTR("OCRAM"), g_ocram[0], g_ocram[1]);
+    if (external_psram_size) {
+        run(PSTR("PSRAM"), g_psram[0], g_psram[1]);
+    }
+
+    print_result(PSTR("memset 64 byte (newlib)"), measure([]() { std::memset(g_dtcm[0], 0xa5, 64); }));
+    print_result(PSTR("memset 64 byte (pvPortMemset)"), measure([]() { ::pvPortMemset(g_dtcm[0], 0xa5, 64); }));
+
+    ::Serial.println();
+}
+} // namespace benchmark
+#else
+namespace benchmark {
+void memory() {
+    ::Serial.println(PSTR("memory copy bandwidth: only available on teensy 4\r\n"));
+}
+} // namespace benchmark
+#endif // __IMXRT1062__
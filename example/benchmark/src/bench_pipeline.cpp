@@ -0,0 +1,90 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    bench_pipeline.cpp
+ * @brief   Benchmark of the latency per stage of a task pipeline
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "benchmark.h"
+
+#include <array>
+
+
+namespace {
+static constexpr size_t STAGES { 3 };
+
+std::array<TaskHandle_t, STAGES + 1> g_stages; // g_stages[0] is the benchmark task
+bool g_handoff;
+
+/* forwards to the next stage (or back to the benchmark task); all stages run at the priority of the benchmark task */
+void stage_task(void* param) {
+    const size_t next { (reinterpret_cast<size_t>(param) + 1) % g_stages.size() };
+    while (true) {
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#if configUSE_TASK_HANDOFF == 1
+        if (g_handoff) {
+            ::xTaskNotifyGiveAndHandoff(g_stages[next]);
+            continue;
+        }
+#endif
+        ::xTaskNotifyGive(g_stages[next]);
+        taskYIELD();
+    }
+}
+
+uint32_t run() {
+    return benchmark::measure([]() {
+#if configUSE_TASK_HANDOFF == 1
+        if (g_handoff) {
+            ::xTaskNotifyGiveAndHandoff(g_stages[1]);
+        } else
+#endif
+        {
+            ::xTaskNotifyGive(g_stages[1]);
+            taskYIELD();
+        }
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }) / g_stages.size();
+}
+} // namespace
+
+namespace benchmark {
+void pipeline() {
+    ::Serial.printf(PSTR("pipeline (configUSE_TASK_HANDOFF=%d):\r\n"), configUSE_TASK_HANDOFF);
+
+    g_stages[0] = ::xTaskGetCurrentTaskHandle();
+    for (size_t i { 1 }; i < g_stages.size(); ++i) {
+        ::xTaskCreate(stage_task, "stage", 256, reinterpret_cast<void*>(i), ::uxTaskPriorityGet(nullptr), &g_stages[i]);
+    }
+
+    g_handoff = false;
+    print_result(PSTR("  per stage, notify + yield"), run());
+#if configUSE_TASK_HANDOFF == 1
+    g_handoff = true;
+    print_result(PSTR("  per stage, notify + handoff"), run());
+#endif
+
+    for (size_t i { 1 }; i < g_stages.size(); ++i) {
+        ::vTaskDelete(g_stages[i]);
+    }
+    ::Serial.println();
+}
+} // namespace benchmark
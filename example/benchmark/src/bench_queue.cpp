@@ -0,0 +1,68 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    bench_queue.cpp
+ * @brief   Benchmark of queue transfers to a waiting receiver
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "benchmark.h"
+#include "queue.h"
+
+#include <array>
+
+
+namespace {
+using item_t = std::array<uint8_t, 64>;
+
+QueueHandle_t g_request;
+QueueHandle_t g_response;
+
+/* higher priority than the benchmark task, so it is always blocked in xQueueReceive() when an item is sent */
+void echo_task(void*) {
+    item_t item;
+    while (true) {
+        ::xQueueReceive(g_request, &item, portMAX_DELAY);
+        ::xQueueSend(g_response, &item, portMAX_DELAY);
+    }
+}
+} // namespace
+
+namespace benchmark {
+void queue() {
+    ::Serial.printf(PSTR("queue (configUSE_QUEUE_DIRECT_HANDOFF=%d):\r\n"), configUSE_QUEUE_DIRECT_HANDOFF);
+
+    g_request = ::xQueueCreate(4, sizeof(item_t));
+    g_response = ::xQueueCreate(4, sizeof(item_t));
+    TaskHandle_t echo;
+    ::xTaskCreate(echo_task, "echo", 256, nullptr, ::uxTaskPriorityGet(nullptr) + 1, &echo);
+
+    item_t item {};
+    print_result(PSTR("  64 byte request/response"), measure([&item]() {
+        ::xQueueSend(g_request, &item, portMAX_DELAY);
+        ::xQueueReceive(g_response, &item, portMAX_DELAY);
+    }));
+
+    ::vTaskDelete(echo);
+    ::vQueueDelete(g_response);
+    ::vQueueDelete(g_request);
+    ::Serial.println();
+}
+} // namespace benchmark
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    bench_sched.cpp
+ * @brief   Benchmark of context switch and tick costs depending on the number of tasks
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "benchmark.h"
+
+
+namespace {
+static constexpr uint32_t TICKS { 1'000 };
+static constexpr size_t MAX_TASKS { 32 };
+static constexpr uint32_t IRQ_THRESHOLD { 40 }; // loop iterations taking longer are accounted as interrupt time
+
+TaskHandle_t g_bench_task;
+TaskHandle_t g_pong_task;
+TaskHandle_t g_preempt_task;
+
+/* woken by the benchmark task and answers immediately, as it has a higher priority */
+void preempt_task(void*) {
+    while (true) {
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        ::xTaskNotifyGive(g_bench_task);
+    }
+}
+
+void pong_task(void*) {
+    while (true) {
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        ::xTaskNotifyGive(g_bench_task);
+    }
+}
+
+void sleep_task(void*) {
+    while (true) {
+        ::vTaskDelay(pdMS_TO_TICKS(100'000));
+    }
+}
+
+/* average number of cycles per tick spent outside of this task, i.e. in the tick interrupt and other ISRs */
+uint32_t tick_cycles() {
+    TickType_t now { ::xTaskGetTickCount() };
+    while (::xTaskGetTickCount() == now) {
+    }
+
+    const TickType_t end { ::xTaskGetTickCount() + TICKS };
+    uint32_t stolen {};
+    uint32_t last { ARM_DWT_CYCCNT };
+    while (::xTaskGetTickCount() != end) {
+        const uint32_t cycles { ARM_DWT_CYCCNT };
+        if (cycles - last > IRQ_THRESHOLD) {
+            stolen += cycles - last;
+        }
+        last = cycles;
+    }
+
+    return stolen / TICKS;
+}
+
+/* cycles to process ticks that occurred while the scheduler was suspended */
+uint32_t catch_up_cycles(const TickType_t ticks) {
+    const uint32_t start { ARM_DWT_CYCCNT };
+    ::xTaskCatchUpTicks(ticks);
+    return ARM_DWT_CYCCNT - start;
+}
+
+void run(const char* name, const size_t num_tasks) {
+    TaskHandle_t tasks[MAX_TASKS];
+    for (size_t i {}; i < num_tasks; ++i) {
+        ::xTaskCreate(sleep_task, "sleep", 256, nullptr, 1, &tasks[i]);
+    }
+    ::vTaskDelay(2);
+
+    ::Serial.printf(PSTR("  %s:\r\n"), name);
+    /* one round trip consists of two context switches */
+    benchmark::print_result(PSTR("    context switch"), benchmark::measure([]() {
+        ::xTaskNotifyGive(g_pong_task);
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }) / 2);
+    benchmark::print_result(PSTR("    tick + ISRs"), tick_cycles());
+    benchmark::print_result(PSTR("    catch up 10 ticks"), catch_up_cycles(10));
+    benchmark::print_result(PSTR("    catch up 1000 ticks"), catch_up_cycles(1'000));
+
+    for (size_t i {}; i < num_tasks; ++i) {
+        ::vTaskDelete(tasks[i]);
+    }
+}
+} // namespace
+
+namespace benchmark {
+void sched() {
+    ::Serial.printf(PSTR("scheduler (configUSE_TCB_HOT_COLD_LAYOUT=%d, configTCB_POOL_SIZE=%d):\r\n"), configUSE_TCB_HOT_COLD_LAYOUT, configTCB_POOL_SIZE);
+
+    g_bench_task = ::xTaskGetCurrentTaskHandle();
+    ::xTaskCreate(pong_task, "pong", 256, nullptr, ::uxTaskPriorityGet(nullptr), &g_pong_task);
+
+    run(PSTR("2 tasks"), 0);
+    run(PSTR("34 tasks"), MAX_TASKS);
+
+    ::vTaskDelete(g_pong_task);
+
+    /* build with e.g. -DconfigMAX_PRIORITIES=64 or 256 to compare the task selection for more than 32 priorities */
+    ::Serial.printf(PSTR("  configMAX_PRIORITIES=%u:\r\n"), configMAX_PRIORITIES);
+    const UBaseType_t preempt_priority { ::uxTaskPriorityGet(nullptr) + 1 };
+    configASSERT(preempt_priority < configMAX_PRIORITIES);
+    ::xTaskCreate(preempt_task, "preempt", 256, nullptr, preempt_priority, &g_preempt_task);
+    print_result(PSTR("    preemption by higher priority"), measure([]() {
+        ::xTaskNotifyGive(g_preempt_task);
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }) / 2);
+    ::vTaskDelete(g_preempt_task);
+
+    ::Serial.println();
+}
+} // namespace benchmark
@@ -0,0 +1,103 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    bench_slice.cpp
+ * @brief   Benchmark of round robin time slices with batch and interactive tasks
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "benchmark.h"
+
+#include <array>
+
+
+namespace {
+static constexpr size_t BATCH_TASKS { 3 };
+static constexpr size_t INTERACTIVE_TASKS { 2 };
+static constexpr uint32_t DURATION_MS { 1'000 };
+
+volatile uintptr_t g_last_runner;
+volatile uint32_t g_switches;
+volatile uint32_t g_batch_loops;
+
+void count_switch(void* self) {
+    if (g_last_runner != reinterpret_cast<uintptr_t>(self)) {
+        g_last_runner = reinterpret_cast<uintptr_t>(self);
+        ++g_switches;
+    }
+}
+
+/* never blocks */
+void batch_task(void*) {
+    while (true) {
+        count_switch(::xTaskGetCurrentTaskHandle());
+        ++g_batch_loops;
+    }
+}
+
+/* short bursts of work, then waits for the next event */
+void interactive_task(void*) {
+    while (true) {
+        const uint32_t start { ARM_DWT_CYCCNT };
+        while (ARM_DWT_CYCCNT - start < F_CPU / 10'000) {
+            count_switch(::xTaskGetCurrentTaskHandle());
+        }
+        ::vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
+void run(const char* name, const TickType_t batch_slice, const TickType_t interactive_slice) {
+    std::array<TaskHandle_t, BATCH_TASKS + INTERACTIVE_TASKS> tasks;
+    for (size_t i {}; i < tasks.size(); ++i) {
+        const bool batch { i < BATCH_TASKS };
+        ::xTaskCreate(batch ? batch_task : interactive_task, batch ? "batch" : "inter", 256, nullptr, 1, &tasks[i]);
+#if configUSE_TASK_TIME_SLICES == 1
+        ::vTaskSetTimeSlice(tasks[i], batch ? batch_slice : interactive_slice);
+#else
+        (void) batch_slice;
+        (void) interactive_slice;
+#endif
+    }
+
+    g_switches = 0;
+    g_batch_loops = 0;
+    ::vTaskDelay(pdMS_TO_TICKS(DURATION_MS));
+    const uint32_t switches { g_switches };
+    const uint32_t loops { g_batch_loops };
+
+    for (auto task : tasks) {
+        ::vTaskDelete(task);
+    }
+    ::Serial.printf(PSTR("  %-30s %6" PRIu32 " switches/s %8" PRIu32 " batch loops/ms\r\n"), name, switches * 1'000 / DURATION_MS, loops / DURATION_MS);
+}
+} // namespace
+
+namespace benchmark {
+void slice() {
+    ::Serial.printf(PSTR("time slices (configUSE_TASK_TIME_SLICES=%d, configTASK_TIME_SLICE_CARRY_OVER=%d):\r\n"), configUSE_TASK_TIME_SLICES,
+        configTASK_TIME_SLICE_CARRY_OVER);
+
+    /* the benchmark task runs at a higher priority and only wakes up to collect the results */
+    run(PSTR("1 tick for all"), 1, 1);
+    run(PSTR("batch 20 ticks, interactive 2"), 20, 2);
+
+    ::Serial.println();
+}
+} // namespace benchmark
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    bench_timer.cpp
+ * @brief   Benchmark of software timers with C++ callables
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#include "benchmark.h"
+#include "timers.h"
+
+
+namespace {
+static constexpr TickType_t PERIOD_TICKS { 10 };
+
+volatile uint32_t g_counter;
+
+/* the usual way to pass state to a C timer callback */
+struct timer_context {
+    volatile uint32_t* p_counter;
+    uint32_t step;
+};
+
+void c_callback(TimerHandle_t handle) {
+    auto p_context { static_cast<timer_context*>(::pvTimerGetTimerID(handle)) };
+    *p_context->p_counter += p_context->step;
+}
+} // namespace
+
+namespace benchmark {
+void timers() {
+    ::Serial.println(PSTR("software timers (create, start, delete):"));
+
+    const uint32_t step { 1 };
+
+    print_result(PSTR("  xTimerCreate with heap context"), measure([step]() {
+        auto p_context { new timer_context { &g_counter, step } };
+        TimerHandle_t handle { ::xTimerCreate("t", PERIOD_TICKS, pdFALSE, p_context, c_callback) };
+        xTimerStart(handle, portMAX_DELAY);
+        xTimerDelete(handle, portMAX_DELAY);
+        delete p_context;
+    }));
+
+    print_result(PSTR("  freertos::timer"), measure([step]() {
+        freertos::timer timer { "t", std::chrono::milliseconds { PERIOD_TICKS }, false, [step]() { g_counter += step; } };
+        timer.start();
+    }));
+
+    freertos::timer timer { "t", std::chrono::milliseconds { PERIOD_TICKS }, false, [step]() { g_counter += step; } };
+    print_result(PSTR("  freertos::timer re-arm"), measure([&timer]() { timer.reset(); }));
+
+    ::Serial.println();
+}
+} // namespace benchmark
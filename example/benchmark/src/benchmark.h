@@ -0,0 +1,70 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    benchmark.h
+ * @brief   Micro benchmarks for the FreeRTOS port to Teensy boards
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#pragma once
+
+#include "arduino_freertos.h"
+
+#include <cinttypes>
+
+
+namespace benchmark {
+static constexpr uint32_t ITERATIONS { 10'000 };
+
+/**
+ * @brief Run a function ITERATIONS times and return the average number of CPU cycles per call
+ * @param[in] func: Function to measure
+ * @return Average cycles per call
+ */
+template <typename F>
+static inline uint32_t measure(F&& func) {
+    const uint32_t start { ARM_DWT_CYCCNT };
+    for (uint32_t i {}; i < ITERATIONS; ++i) {
+        func();
+    }
+    const uint32_t cycles { ARM_DWT_CYCCNT - start };
+
+    return (cycles + ITERATIONS / 2) / ITERATIONS;
+}
+
+/**
+ * @brief Print a single benchmark result to Serial
+ * @param[in] name: Name of the benchmark
+ * @param[in] cycles: Measured cycles per operation
+ */
+static inline void print_result(const char* name, const uint32_t cycles) {
+    ::Serial.printf(PSTR("%-32s %6" PRIu32 " cycles\r\n"), name, cycles);
+}
+
+void atomic();
+void sched();
+void queue();
+void channel();
+void pipeline();
+void slice();
+void irq();
+void timers();
+void memory();
+} // namespace benchmark
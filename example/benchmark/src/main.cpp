@@ -0,0 +1,68 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    main.cpp
+ * @brief   FreeRTOS benchmark example for Teensy boards
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "arduino_freertos.h"
+#include "avr/pgmspace.h"
+#include "benchmark.h"
+
+
+static void bench_task(void*) {
+    ::Serial.println(PSTR("\r\nRunning benchmarks...\r\n"));
+
+    benchmark::atomic();
+    benchmark::sched();
+    benchmark::queue();
+    benchmark::channel();
+    benchmark::pipeline();
+    benchmark::slice();
+    benchmark::irq();
+    benchmark::timers();
+    benchmark::memory();
+
+    ::Serial.println(PSTR("\r\nBenchmarks done."));
+    ::Serial.flush();
+
+    ::vTaskSuspend(nullptr);
+}
+
+FLASHMEM __attribute__((noinline)) void setup() {
+    ::Serial.begin(0);
+    ::delay(2'000);
+
+    ::Serial.println(PSTR("\r\nBooting FreeRTOS kernel " tskKERNEL_VERSION_NUMBER ". Built by gcc " __VERSION__ " (newlib " _NEWLIB_VERSION ") on " __DATE__ ". ***\r\n"));
+
+    /* make sure the cycle counter is running (not enabled by default on teensy 3.x) */
+    ARM_DEMCR |= ARM_DEMCR_TRCENA;
+    ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+
+    ::xTaskCreate(bench_task, "bench", 2'048, nullptr, configMAX_PRIORITIES - 2, nullptr);
+
+    ::Serial.println(PSTR("setup(): starting scheduler..."));
+    ::Serial.flush();
+
+    ::vTaskStartScheduler();
+}
+
+void loop() {}
@@ -30,6 +30,8 @@
 
 #include <thread>
 #include <future>
+#include <mutex>
+#include <condition_variable>
 #include <chrono>
 #include <string>
 #include <ctime>
@@ -127,6 +129,26 @@ static void task3(void*) {
         configASSERT(7 + 8 + 9 == r1 + r2 + r3);
     }
 
+    {
+        // condition variable wait ended by a stop request
+        std::mutex m;
+        std::condition_variable_any cv;
+        std::jthread t3 { [&m, &cv](std::stop_token stop) {
+            std::unique_lock lock { m };
+            const bool ready { cv.wait(lock, stop, [] { return false; }) };
+            ::Serial.printf(PSTR("t3 woken up, ready=%d stop_requested=%d\n\r"), ready, stop.stop_requested());
+            ::Serial.flush();
+        } };
+
+        std::this_thread::sleep_for(100ms);
+        t3.request_stop();
+    }
+
+    std::stop_callback callback { g_t1->get_stop_token(), []() {
+        ::Serial.println(PSTR("t1 stop callback called."));
+        ::Serial.flush();
+    } };
+
     if (g_t1->request_stop()) {
         ::Serial.println(PSTR("t1 stop_request successful."));
     } else {
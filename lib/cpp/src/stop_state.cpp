@@ -0,0 +1,146 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    stop_state.cpp
+ * @brief   Shared state of std::stop_source, std::stop_token and std::stop_callback for FreeRTOS
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "arduino_freertos.h"
+
+#if _GCC_VERSION >= 60100 && defined PLATFORMIO
+#include "stop_state.h"
+
+
+namespace free_rtos_std {
+
+bool stop_state::request_stop() {
+    {
+        critical_section critical;
+
+        if (_stop_requested) {
+            return false;
+        }
+        _stop_requested = true;
+        _requester = ::xTaskGetCurrentTaskHandle();
+    }
+
+    while (true) {
+        callback_base* cb;
+        {
+            critical_section critical;
+
+            cb = _head;
+            if (!cb) {
+                _running = nullptr;
+                _requester = nullptr;
+                break;
+            }
+            _head = cb->_next;
+            if (_head) {
+                _head->_prev = nullptr;
+            }
+            cb->_prev = cb->_next = nullptr;
+            _running = cb;
+        }
+
+        bool destroyed { false };
+        cb->_destroyed = &destroyed;
+        cb->_foo(cb);
+
+        if (!destroyed) {
+            TaskHandle_t waiter;
+            {
+                critical_section critical;
+
+                cb->_destroyed = nullptr;
+                _running = nullptr;
+                waiter = cb->_waiter;
+            }
+
+            // the waiting task may release cb as soon as it is notified
+            if (waiter) {
+                ::xTaskNotifyGiveIndexed(waiter, NOTIFICATION_INDEX);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool stop_state::add_callback(callback_base* cb) {
+    {
+        critical_section critical;
+
+        if (!_stop_requested) {
+            if (!_sources) {
+                return false;
+            }
+
+            cb->_next = _head;
+            if (_head) {
+                _head->_prev = cb;
+            }
+            _head = cb;
+            return true;
+        }
+    }
+
+    cb->_foo(cb);
+    return false;
+}
+
+void stop_state::remove_callback(callback_base* cb) {
+    {
+        critical_section critical;
+
+        if (_head == cb || cb->_prev) { // not executed yet, just unlink it
+            if (cb->_prev) {
+                cb->_prev->_next = cb->_next;
+            } else {
+                _head = cb->_next;
+            }
+            if (cb->_next) {
+                cb->_next->_prev = cb->_prev;
+            }
+            return;
+        }
+
+        if (_running != cb) { // already finished
+            return;
+        }
+
+        if (_requester == ::xTaskGetCurrentTaskHandle()) { // callback destroys itself
+            if (cb->_destroyed) {
+                *cb->_destroyed = true;
+            }
+            return;
+        }
+
+        cb->_waiter = ::xTaskGetCurrentTaskHandle();
+    }
+
+    // callback is running in another task, wait until it has returned
+    while (::ulTaskNotifyTakeIndexed(NOTIFICATION_INDEX, pdTRUE, portMAX_DELAY) == 0) {
+    }
+}
+
+} // namespace free_rtos_std
+#endif // _GCC_VERSION >= 60100 && PLATFORMIO
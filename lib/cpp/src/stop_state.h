@@ -0,0 +1,186 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    stop_state.h
+ * @brief   Shared state of std::stop_source, std::stop_token and std::stop_callback for FreeRTOS
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#pragma once
+
+#include "arduino_freertos.h"
+#include "critical_section.h"
+
+#include <cstdint>
+#include <utility>
+
+
+namespace free_rtos_std {
+
+// 1. libstdc++ spins with __gthread_yield() while a stop callback is running
+//    on another thread. taskYIELD() never lets a lower priority task run, so
+//    a high priority task destroying a std::stop_callback could hang forever.
+// 2. Here the state is protected by a critical section and a task destroying
+//    a callback that is currently executed blocks on a task notification
+//    until request_stop() has finished the callback.
+// 3. A callback may destroy itself (or request_stop() may be called from
+//    a callback), in this case nothing is waited for.
+class stop_state {
+public:
+    // reserved in FreeRTOSConfig.h, index configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 is used by condition_variable
+    static constexpr UBaseType_t NOTIFICATION_INDEX { configSTOP_STATE_NOTIFICATION_INDEX };
+    static_assert(NOTIFICATION_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES - 1, "configSTOP_STATE_NOTIFICATION_INDEX out of range");
+
+    struct callback_base {
+        typedef void (*callback_foo)(callback_base*);
+
+        explicit callback_base(callback_foo foo) : _foo { foo } {}
+
+        callback_foo _foo;
+        callback_base* _prev { nullptr };
+        callback_base* _next { nullptr };
+        TaskHandle_t _waiter { nullptr }; // task blocked in remove_callback() until _foo has returned
+        bool* _destroyed { nullptr }; // set by remove_callback() if _foo destroys its own callback
+    };
+
+    stop_state() = default;
+
+    void add_owner() {
+        critical_section critical;
+        ++_owners;
+    }
+
+    void release_owner() {
+        bool last;
+        {
+            critical_section critical;
+            last = --_owners == 0;
+        }
+
+        if (last) {
+            delete this;
+        }
+    }
+
+    void add_source() {
+        critical_section critical;
+        ++_sources;
+    }
+
+    void remove_source() {
+        critical_section critical;
+        --_sources;
+    }
+
+    bool stop_requested() const {
+        critical_section critical;
+        return _stop_requested;
+    }
+
+    bool stop_possible() const {
+        critical_section critical;
+        return _stop_requested || _sources;
+    }
+
+    bool request_stop();
+
+    // Registers cb. If stop was already requested, cb is executed immediately
+    // and false is returned. Returns false as well if stop is not possible.
+    bool add_callback(callback_base* cb);
+
+    // Unregisters cb. Blocks if cb is currently executed by another task.
+    void remove_callback(callback_base* cb);
+
+    stop_state(const stop_state&) = delete;
+    stop_state& operator=(const stop_state&) = delete;
+
+private:
+    ~stop_state() = default;
+
+    callback_base* _head { nullptr };
+    callback_base* _running { nullptr };
+    TaskHandle_t _requester { nullptr };
+    uint32_t _owners { 1 };
+    uint32_t _sources { 0 };
+    bool _stop_requested { false };
+};
+
+// Reference counting handle of a stop_state
+class stop_state_ref {
+public:
+    stop_state_ref() = default;
+
+    static stop_state_ref create() {
+        auto p_state { new stop_state };
+        configASSERT(p_state);
+        return stop_state_ref { p_state };
+    }
+
+    stop_state_ref(const stop_state_ref& r) : _state { r._state } {
+        if (_state) {
+            _state->add_owner();
+        }
+    }
+
+    stop_state_ref(stop_state_ref&& r) noexcept : _state { std::exchange(r._state, nullptr) } {}
+
+    stop_state_ref& operator=(const stop_state_ref& r) {
+        if (this != &r) {
+            stop_state_ref tmp { r };
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    stop_state_ref& operator=(stop_state_ref&& r) noexcept {
+        stop_state_ref tmp { std::move(r) };
+        swap(tmp);
+        return *this;
+    }
+
+    ~stop_state_ref() {
+        if (_state) {
+            _state->release_owner();
+        }
+    }
+
+    void swap(stop_state_ref& r) noexcept {
+        std::swap(_state, r._state);
+    }
+
+    explicit operator bool() const noexcept {
+        return _state != nullptr;
+    }
+
+    stop_state* operator->() const noexcept {
+        return _state;
+    }
+
+    bool operator==(const stop_state_ref& r) const noexcept {
+        return _state == r._state;
+    }
+
+private:
+    explicit stop_state_ref(stop_state* p_state) : _state { p_state } {}
+
+    stop_state* _state { nullptr };
+};
+
+} // namespace free_rtos_std
@@ -41,7 +41,6 @@
 
 #include <thread>
 #include <cerrno>
-#include <cstring>
 
 
 // trick to fool libgcc and make it detects we are using threads
@@ -153,11 +152,8 @@ extern Key* s_key;
 namespace std {
 
 static void __execute_native_thread_routine(void* __p) {
-    __gthread_t local { *static_cast<__gthread_t*>(__p) }; // copy
-
-    { // we own the arg now; it must be deleted after run() returns
-        thread::_State_ptr __t { static_cast<thread::_State*>(local.arg()) };
-        local.notify_started(); // copy has been made; tell we are running
+    { // we own the arg since creation; it must be deleted after run() returns
+        thread::_State_ptr __t { static_cast<thread::_State*>(__p) };
         __t->_M_run();
     }
 
@@ -165,7 +161,7 @@ static void __execute_native_thread_routine(void* __p) {
         free_rtos_std::s_key->CallDestructor(__gthread_t::self().native_task_handle());
     }
 
-    local.notify_joined(); // finished; release joined threads
+    __gthread_t::self().notify_joined(); // finished; release joined threads
 }
 
 thread::_State::~_State() = default;
@@ -244,9 +240,7 @@ void gthr_freertos::set_priority(std::thread* p_thread, const uint32_t prio) {
 }
 
 void gthr_freertos::set_name(std::thread* p_thread, const char* task_name) {
-    auto p_name { ::pcTaskGetName(p_thread->native_handle().get_native_handle()) };
-    std::strncpy(p_name, task_name, configMAX_TASK_NAME_LEN - 1);
-    p_name[configMAX_TASK_NAME_LEN - 1] = 0;
+    ::vTaskSetName(p_thread->native_handle().get_native_handle(), task_name);
 }
 
 void gthr_freertos::suspend(std::thread* p_thread) {
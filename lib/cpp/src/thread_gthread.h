@@ -57,8 +57,10 @@ class gthr_freertos {
     //    even if the std::thread instance has been destroyed. The native
     //    thread function must take the ownership of any resources allocated
     //    during the thread creation. This could be the thread handle itself.
-    //    Detach must make sure that the thread has started execution and
-    //    the ownership has been taken.
+    //    The native thread function gets the thread argument as task
+    //    parameter and finds the events group in its thread local storage.
+    //    It never accesses the std::thread instance, so neither detach nor
+    //    move have to wait for the thread to start execution.
     // 3. Join requires a way to switch the current context to a waiting
     //    state. The native thread function must have a way to unlock
     //    a joined thread.
@@ -83,7 +85,7 @@ class gthr_freertos {
     friend std::thread;
     friend std::stop_token;
 
-    enum { eEvStoragePos = 0, eStartedEv = 1 << 22, eJoinEv = 1 << 23 };
+    enum { eEvStoragePos = 0, eJoinEv = 1 << 23 };
 
     static constexpr StackType_t DEFAULT_STACK_SIZE { 2 * 1024 }; // byte
     static StackType_t next_stack_size_;
@@ -102,17 +104,10 @@ public:
     }
 
     gthr_freertos(gthr_freertos&& r) {
-        taskENTER_CRITICAL();
-        if (r._fOwner) {
-            taskEXIT_CRITICAL();
-            // make sure it has already started
-            // - native thread function must make local copies first
-            r.wait_for_start();
-            taskENTER_CRITICAL();
-        }
+        critical_section critical;
+
         // 'this' becomes the owner if r is the owner
         move(std::forward<gthr_freertos>(r));
-        taskEXIT_CRITICAL();
     }
 
     bool create_thread(task_foo foo, void* arg) {
@@ -127,7 +122,8 @@ public:
         {
             critical_section critical;
 
-            xTaskCreate(foo, "Task", next_stack_size_ ? next_stack_size_ / sizeof(StackType_t) : DEFAULT_STACK_SIZE / sizeof(StackType_t), this,
+            // the argument is handed over at creation, the task does not access 'this'
+            xTaskCreate(foo, "Task", next_stack_size_ ? next_stack_size_ / sizeof(StackType_t) : DEFAULT_STACK_SIZE / sizeof(StackType_t), arg,
                 tskIDLE_PRIORITY + 1, &_taskHandle);
             // if (!_taskHandle) {
             //     std::terminate();
@@ -154,34 +150,26 @@ public:
         //   checking if the task still exists and use critical section if it does.
         //   It is faster to use _evHandle directly, even if it is an extra item to
         //   copy each time when this instance is copied.
-        while (0 == xEventGroupWaitBits(_evHandle, eJoinEv | eStartedEv, pdFALSE, pdTRUE, portMAX_DELAY))
+        while (0 == xEventGroupWaitBits(_evHandle, eJoinEv, pdFALSE, pdTRUE, portMAX_DELAY))
             ;
     }
 
-    void detach() { // Detaching is removing the event's object. It can be done
-        // only if the thread has started execution.
-        wait_for_start();
-
-        { // unfortunately critical section is needed here to make sure
-            // the task is not deleted while accessing the task's local storage.
-            critical_section critical;
-
-            if (eDeleted != eTaskGetState(_taskHandle)) {
-                vTaskSetThreadLocalStoragePointer(_taskHandle, eEvStoragePos, nullptr);
-                vEventGroupDelete(_evHandle);
+    void detach() { // Detaching is removing the event's object. The thread may
+        // not have started execution yet, it owns its argument already.
+        // Critical section is needed here to make sure the task does not
+        // finish while accessing the task's local storage, see notify_joined.
+        critical_section critical;
 
-                // Thread still exists but detach removes ownership.
-                // Ownership belongs to the native thread. It will release the task
-                // handle once user's thread function exits.
-                _fOwner = false;
-            }
+        if (!finished()) {
+            vTaskSetThreadLocalStoragePointer(_taskHandle, eEvStoragePos, nullptr);
         }
-    }
+        vEventGroupDelete(_evHandle);
+        _evHandle = nullptr;
 
-    void notify_started() { // Function should be called only from the controlled task
-        // and only when the (internal, not application's one) thread function
-        // has started execution.
-        xEventGroupSetBits(_evHandle, eStartedEv);
+        // Thread may still exist but detach removes ownership.
+        // Ownership belongs to the native thread. It will release the task
+        // handle once user's thread function exits.
+        _fOwner = false;
     }
 
     void notify_joined() { // Function should be called only from the controlled task
@@ -272,19 +260,13 @@ private:
             // new ownership. If 'r' is not the owner then
             // just a copy is being moved. Either way 'this'
             // ownership is lost and handles must be deleted.
-            if (eDeleted != eTaskGetState(_taskHandle)) {
+            if (!finished()) {
                 vTaskDelete(_taskHandle);
             }
             if (_evHandle) {
                 vEventGroupDelete(_evHandle);
             }
             _fOwner = false;
-        } else if (r._fOwner) {
-            taskEXIT_CRITICAL();
-            // make sure it has already started
-            // - native thread function must make local copies first
-            r.wait_for_start();
-            taskENTER_CRITICAL();
         }
         // 'this' becomes the owner if r is the owner
         move(std::forward<gthr_freertos>(r));
@@ -303,9 +285,10 @@ private:
         r._fOwner = false;
     }
 
-    void wait_for_start() {
-        while (0 == xEventGroupWaitBits(_evHandle, eStartedEv, pdFALSE, pdTRUE, portMAX_DELAY))
-            ;
+    // Only valid for the owner. The task handle may already be reused by another
+    // task once the thread has finished, so its state can't be checked.
+    bool finished() const {
+        return (xEventGroupGetBits(_evHandle) & eJoinEv) != 0;
     }
 
     native_task_type _taskHandle { nullptr };
@@ -0,0 +1,10 @@
+#!/bin/sh
+# build and run the host tests, with and without NDEBUG
+set -e
+cd "$(dirname "$0")"
+out=$(mktemp -d)
+trap 'rm -rf "$out"' EXIT
+for flags in "" "-DNDEBUG"; do
+    g++ -std=gnu++20 -Wall -Wextra -Werror $flags -Itest/host/shim -Isrc/portable test/host/dma_buffer_test.cpp src/portable/dma_buffer.cpp -o "$out/dma_buffer_test"
+    "$out/dma_buffer_test"
+done
@@ -541,6 +541,14 @@
     #define portTASK_SWITCH_HOOK( pxTCB )    ( void ) ( pxTCB )
 #endif
 
+#ifndef portMEMCPY
+    #define portMEMCPY( pvDst, pvSrc, xSize )    memcpy( ( pvDst ), ( pvSrc ), ( xSize ) )
+#endif
+
+#ifndef portMEMSET
+    #define portMEMSET( pvDst, iValue, xSize )    memset( ( pvDst ), ( iValue ), ( xSize ) )
+#endif
+
 #ifndef configQUEUE_REGISTRY_SIZE
     #define configQUEUE_REGISTRY_SIZE    0U
 #endif
@@ -2733,6 +2741,161 @@
     #define configUSE_SB_COMPLETED_CALLBACK    0
 #endif
 
+#ifndef configUSE_TASK_NAME_INDEX
+
+/* Defaults to searching all task lists in xTaskGetHandle(). */
+    #define configUSE_TASK_NAME_INDEX    0
+#endif
+
+#ifndef configTASK_NAME_INDEX_SIZE
+
+/* Number of slots of the task name index, must be a power of two.  Tasks
+ * that don't fit are found by searching the task lists. */
+    #define configTASK_NAME_INDEX_SIZE    32
+#endif
+
+#if ( configUSE_TASK_NAME_INDEX == 1 )
+    #if ( ( configTASK_NAME_INDEX_SIZE & ( configTASK_NAME_INDEX_SIZE - 1 ) ) != 0 )
+        #error configTASK_NAME_INDEX_SIZE must be a power of two
+    #endif
+#endif
+
+#ifndef configUSE_TASK_REAPER
+
+/* Defaults to freeing the memory of tasks that deleted themselves from within
+ * the idle task. */
+    #define configUSE_TASK_REAPER    0
+#endif
+
+#ifndef configTASK_REAPER_PRIORITY
+    #define configTASK_REAPER_PRIORITY    ( configMAX_PRIORITIES - 1 )
+#endif
+
+#ifndef configTASK_REAPER_STACK_DEPTH
+    #define configTASK_REAPER_STACK_DEPTH    configMINIMAL_STACK_SIZE
+#endif
+
+#ifndef configTASK_RECYCLE_CACHE_SIZE
+
+/* Number of TCB and stack pairs of deleted tasks that are kept for reuse by
+ * xTaskCreate().  0 returns them to the heap immediately. */
+    #define configTASK_RECYCLE_CACHE_SIZE    0
+#endif
+
+#ifndef configUSE_TCB_HOT_COLD_LAYOUT
+
+/* Defaults to the upstream TCB layout. */
+    #define configUSE_TCB_HOT_COLD_LAYOUT    0
+#endif
+
+#ifndef configUSE_QUEUE_CACHE_LINE_ALIGNMENT
+
+/* Set to 1 to start dynamically allocated queues on a cache line, so the
+ * fields used by every send and receive span as few cache lines as possible. */
+    #define configUSE_QUEUE_CACHE_LINE_ALIGNMENT    0
+#endif
+
+#ifndef configTCB_POOL_SIZE
+
+/* Number of TCBs statically reserved for dynamically created tasks, e.g. to
+ * place them in tightly coupled memory.  0 allocates all TCBs from the heap. */
+    #define configTCB_POOL_SIZE    0
+#endif
+
+#ifndef portCACHE_LINE_SIZE
+    #define portCACHE_LINE_SIZE    portBYTE_ALIGNMENT
+#endif
+
+#ifndef portCACHE_LINE_ALIGNED
+    #define portCACHE_LINE_ALIGNED
+#endif
+
+/* Alignment of the first TCB field not used by the scheduler, see tskTCB. */
+#ifndef portTCB_COLD_DATA
+    #if ( configUSE_TCB_HOT_COLD_LAYOUT == 1 )
+        #define portTCB_COLD_DATA    portCACHE_LINE_ALIGNED
+    #else
+        #define portTCB_COLD_DATA
+    #endif
+#endif
+
+#ifndef configUSE_QUEUE_DIRECT_HANDOFF
+
+/* Defaults to passing every item through the queue storage area. */
+    #define configUSE_QUEUE_DIRECT_HANDOFF    0
+#endif
+
+#ifndef configUSE_CHANNELS
+    #define configUSE_CHANNELS    0
+#endif
+
+#ifndef configUSE_TASK_TIME_SLICES
+
+/* Set to 1 to give each task its own round robin quantum, see
+ * vTaskSetTimeSlice(). */
+    #define configUSE_TASK_TIME_SLICES    0
+#endif
+
+#ifndef configTASK_TIME_SLICE_TICKS
+
+/* Quantum of new tasks, 0 disables time slicing for them. */
+    #define configTASK_TIME_SLICE_TICKS    configUSE_TIME_SLICING
+#endif
+
+#ifndef configTASK_TIME_SLICE_CARRY_OVER
+    #define configTASK_TIME_SLICE_CARRY_OVER    0
+#endif
+
+#ifndef configUSE_TASK_HANDOFF
+
+/* Set to 1 to include xTaskNotifyGiveAndHandoff(), which switches directly to
+ * the notified task. */
+    #define configUSE_TASK_HANDOFF    0
+#endif
+
+#ifndef configUSE_TASK_STATE_STATS
+
+/* Set to 1 to record the object a task is blocked on and to accumulate the
+ * time each task spends in each state, see xTaskGetStateStats(). */
+    #define configUSE_TASK_STATE_STATS    0
+#endif
+
+#ifndef configUSE_LOCK_STATS
+
+/* Set to 1 to report the wait and hold times of mutexes per lock and callsite
+ * to the port, which must provide portLOCK_STATS_CALLSITE() and
+ * portLOCK_STATS_TIME(). */
+    #define configUSE_LOCK_STATS    0
+#endif
+
+#if ( ( configUSE_LOCK_STATS == 1 ) && ( !defined( portLOCK_STATS_CALLSITE ) || !defined( portLOCK_STATS_TIME ) ) )
+    #error configUSE_LOCK_STATS requires the port to define portLOCK_STATS_CALLSITE() and portLOCK_STATS_TIME()
+#endif
+
+#ifndef configREADY_LATENCY_BUCKETS
+
+/* Number of power of two buckets of the ready latency histogram. */
+    #define configREADY_LATENCY_BUCKETS    16
+#endif
+
+/* Running, Ready and one entry per eBlockedOnType, where the entry of
+ * eBlockedOnNothing holds the Suspended time. */
+#define tskSTATE_STATS_ENTRIES    ( 11 )
+
+/* The handoff fields of the TCB are used by queues and channels. */
+#if ( ( configUSE_QUEUE_DIRECT_HANDOFF == 1 ) || ( configUSE_CHANNELS == 1 ) )
+    #define tskHANDOFF_BUFFER_POSSIBLE    1
+#else
+    #define tskHANDOFF_BUFFER_POSSIBLE    0
+#endif
+
+#ifndef configUSE_GCC_BUILTIN_ATOMICS
+
+/* Defaults to the interrupt masking implementation of the functions in
+ * atomic.h. */
+    #define configUSE_GCC_BUILTIN_ATOMICS    0
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
     #define portTICK_TYPE_IS_ATOMIC    0
 #endif
@@ -2761,6 +2924,28 @@
     #endif
 #endif
 
+#if ( configUSE_TASK_REAPER == 1 )
+    #if ( ( INCLUDE_vTaskDelete != 1 ) || ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) || ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+        #error configUSE_TASK_REAPER requires INCLUDE_vTaskDelete, configSUPPORT_DYNAMIC_ALLOCATION and configUSE_TASK_NOTIFICATIONS to be set to 1
+    #endif
+#endif
+
+#if ( ( configUSE_TASK_TIME_SLICES == 1 ) && ( configNUMBER_OF_CORES != 1 ) )
+    #error configUSE_TASK_TIME_SLICES is only supported on a single core
+#endif
+
+#if ( configUSE_TASK_STATE_STATS == 1 )
+    #if ( ( configGENERATE_RUN_TIME_STATS != 1 ) || ( configNUMBER_OF_CORES != 1 ) )
+        #error configUSE_TASK_STATE_STATS requires configGENERATE_RUN_TIME_STATS to be set to 1 and a single core
+    #endif
+#endif
+
+#if ( configUSE_TASK_HANDOFF == 1 )
+    #if ( ( configUSE_TASK_NOTIFICATIONS != 1 ) || ( configNUMBER_OF_CORES != 1 ) )
+        #error configUSE_TASK_HANDOFF requires configUSE_TASK_NOTIFICATIONS to be set to 1 and a single core
+    #endif
+#endif
+
 #ifndef configSTATS_BUFFER_MAX_LENGTH
     #define configSTATS_BUFFER_MAX_LENGTH    0xFFFF
 #endif
@@ -3088,7 +3273,18 @@ typedef struct xSTATIC_TCB
         BaseType_t xDummy23;
         UBaseType_t uxDummy24;
     #endif
-    uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
+    #if ( configUSE_TASK_TIME_SLICES == 1 )
+        TickType_t xDummy30[ 2 ];
+    #endif
+    #if ( configUSE_TCB_HOT_COLD_LAYOUT == 1 )
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulDummy16;
+        #endif
+        #if ( configUSE_POSIX_ERRNO == 1 )
+            int iDummy22;
+        #endif
+    #endif
+    uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ] portTCB_COLD_DATA;
     #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
         BaseType_t xDummy25;
     #endif
@@ -3110,7 +3306,7 @@ typedef struct xSTATIC_TCB
     #if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
         void * pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
     #endif
-    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TCB_HOT_COLD_LAYOUT == 0 ) )
         configRUN_TIME_COUNTER_TYPE ulDummy16;
     #endif
     #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
@@ -3127,9 +3323,22 @@ typedef struct xSTATIC_TCB
     #if ( INCLUDE_xTaskAbortDelay == 1 )
         uint8_t ucDummy21;
     #endif
-    #if ( configUSE_POSIX_ERRNO == 1 )
+    #if ( ( configUSE_POSIX_ERRNO == 1 ) && ( configUSE_TCB_HOT_COLD_LAYOUT == 0 ) )
         int iDummy22;
     #endif
+    #if ( configTASK_RECYCLE_CACHE_SIZE > 0 )
+        configSTACK_DEPTH_TYPE uxDummy27;
+    #endif
+    #if ( tskHANDOFF_BUFFER_POSSIBLE == 1 )
+        void * pvDummy28;
+        uint8_t ucDummy29;
+    #endif
+    #if ( configUSE_TASK_STATE_STATS == 1 )
+        void * pvDummy31;
+        uint8_t ucDummy32[ 3 ];
+        configRUN_TIME_COUNTER_TYPE ulDummy33[ tskSTATE_STATS_ENTRIES + 1 ];
+        uint32_t ulDummy34[ configREADY_LATENCY_BUCKETS ];
+    #endif
 } StaticTask_t;
 
 /*
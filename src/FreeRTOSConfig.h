@@ -55,23 +55,36 @@ extern "C" {
 #define configSYSTICK_CLOCK_HZ                      ( 100000UL )
 #define configTICK_RATE_HZ                          ( (TickType_t) 1000 )
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION     1
+#ifndef configMAX_PRIORITIES
 #define configMAX_PRIORITIES                        ( 10 )
+#endif
 #define configMINIMAL_STACK_SIZE                    ( ( unsigned short ) 128 )
 #define configMAX_TASK_NAME_LEN                     ( 10 )
 #define configTICK_TYPE_WIDTH_IN_BITS               TICK_TYPE_WIDTH_32_BITS
 #define configIDLE_SHOULD_YIELD                     1
 #define configUSE_TASK_NOTIFICATIONS                1
-#define configTASK_NOTIFICATION_ARRAY_ENTRIES       4
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES       7
+/* Task notification indices 0 to 2 are free for the application, the port reserves the ones above. Each blocking wait of the port gets
+ * its own index, so a stray notification never wakes another waiter of the same task. Index configTASK_NOTIFICATION_ARRAY_ENTRIES - 1
+ * is used by std::condition_variable and std::thread. */
+#define configSTOP_STATE_NOTIFICATION_INDEX         ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 2 ) /* std::stop_callback destructor (stop_state.h) */
+#define configTIMER_NOTIFICATION_INDEX              ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 3 ) /* freertos::timer destructor waiting for the timer task (portable/timer.h) */
+#define configDMA_COPY_NOTIFICATION_INDEX           ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 4 ) /* task waiting for a DMA copy to complete (portable/memcpy_m7.cpp) */
 #define configUSE_MUTEXES                           1
 #define configUSE_RECURSIVE_MUTEXES                 1
 #define configUSE_COUNTING_SEMAPHORES               1
 #define configQUEUE_REGISTRY_SIZE                   0
 #define configUSE_QUEUE_SETS                        0
+#define configUSE_QUEUE_DIRECT_HANDOFF              1
+#define configUSE_CHANNELS                          1
+#define configUSE_TASK_HANDOFF                      1
 #define configUSE_TIME_SLICING                      0
+#define configUSE_TASK_TIME_SLICES                  1
 #define configUSE_NEWLIB_REENTRANT                  1
 #define configENABLE_BACKWARD_COMPATIBILITY         0
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS     4
 #define configUSE_APPLICATION_TASK_TAG              0
+#define configUSE_TASK_NAME_INDEX                   1
 
 /* Tasks.c additions (e.g. Thread Aware Debug capability) */
 #define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H   1
@@ -80,6 +93,21 @@ extern "C" {
 #define configSUPPORT_STATIC_ALLOCATION             1
 #define configSUPPORT_DYNAMIC_ALLOCATION            1
 #define configAPPLICATION_ALLOCATED_HEAP            0
+/* Cache line aligned TCB cold data and queues only pay off with the data cache of the Cortex-M7, on Teensy 3.x they only add padding. */
+#if defined __IMXRT1062__
+#define configUSE_TCB_HOT_COLD_LAYOUT               1
+#define configUSE_QUEUE_CACHE_LINE_ALIGNMENT        1
+#else
+#define configUSE_TCB_HOT_COLD_LAYOUT               0
+#define configUSE_QUEUE_CACHE_LINE_ALIGNMENT        0
+#endif
+#ifndef configTCB_POOL_SIZE
+#if defined ARDUINO_TEENSY40 || defined ARDUINO_TEENSY41 || defined ARDUINO_TEENSY_MICROMOD
+#define configTCB_POOL_SIZE                         8
+#else
+#define configTCB_POOL_SIZE                         0
+#endif
+#endif
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                         1
@@ -94,6 +122,39 @@ extern "C" {
 #define portGET_RUN_TIME_COUNTER_VALUE()            freertos_get_us()
 #define configUSE_TRACE_FACILITY                    1
 #define configUSE_STATS_FORMATTING_FUNCTIONS        0
+#define configUSE_TASK_STATE_STATS                  0
+
+/* Context switch trace for the console (portable/console.h), only active after "trace start". */
+#define configUSE_SWITCH_TRACE                      1
+#if configUSE_SWITCH_TRACE == 1
+extern volatile uint8_t freertos_switch_trace_enabled;
+void freertos_switch_trace(void* task);
+#define switchTRACE_SWITCHED_IN()                   if (freertos_switch_trace_enabled) { freertos_switch_trace(pxCurrentTCB); }
+#else
+#define switchTRACE_SWITCHED_IN()
+#endif
+
+/* Quiescent state counting for deferred reclamation (portable/rcu.h). A task leaving the ready list on a switch out (blocked, suspended)
+ * sets the low bit of its counter in thread local storage, the following switch in makes it even again. A preempted task stays unchanged. */
+#define configUSE_RCU                               1
+#if configUSE_RCU == 1
+#define configRCU_TLS_INDEX                         2
+#define rcuCOUNTER(pxTCB)                           ((pxTCB)->pvThreadLocalStoragePointers[configRCU_TLS_INDEX])
+#define traceTASK_SWITCHED_OUT()                    do { if (listLIST_ITEM_CONTAINER(&pxCurrentTCB->xStateListItem) != &pxReadyTasksLists[pxCurrentTCB->uxPriority]) { rcuCOUNTER(pxCurrentTCB) = (void*) ((uintptr_t) rcuCOUNTER(pxCurrentTCB) | 1U); } } while (0)
+#define rcuTASK_SWITCHED_IN()                       if ((uintptr_t) rcuCOUNTER(pxCurrentTCB) & 1U) { rcuCOUNTER(pxCurrentTCB) = (void*) ((uintptr_t) rcuCOUNTER(pxCurrentTCB) + 1U); }
+#else
+#define rcuTASK_SWITCHED_IN()
+#endif
+
+#define traceTASK_SWITCHED_IN()                     do { switchTRACE_SWITCHED_IN() rcuTASK_SWITCHED_IN() } while (0)
+
+/* Small object allocator with per-task caches (portable/small_alloc.h), replaces operator new/delete and optionally malloc()/free().
+   Opt-in, as it reserves a static arena of SMALL_ALLOC_ARENA_SIZE byte. */
+#define configUSE_SMALL_OBJECT_ALLOCATOR            0
+#define configSMALL_OBJECT_ALLOCATOR_MALLOC         0
+
+/* Wait and hold times of mutexes per lock and callsite (portable/lock_stats.h), adds a non-blocking try to every mutex take. */
+#define configUSE_LOCK_STATS                        0
 
 /* Task aware debugging. */
 #define configRECORD_STACK_HIGH_ADDRESS             1
@@ -111,6 +172,16 @@ extern "C" {
 #endif
 #define configIDLE_TASK_NAME                        "IDLE"
 
+/* Task reaper definitions. */
+#define configUSE_TASK_REAPER                       1
+#ifndef configTASK_REAPER_PRIORITY
+#define configTASK_REAPER_PRIORITY                  ( configMAX_PRIORITIES - 2 )
+#endif
+#define configTASK_REAPER_STACK_DEPTH               ( 768U / 4U )
+#ifndef configTASK_RECYCLE_CACHE_SIZE
+#define configTASK_RECYCLE_CACHE_SIZE               4
+#endif
+
 /* Define to trap errors during development. */
 #ifdef NDEBUG
 #define configCHECK_HANDLER_INSTALLATION            0
@@ -219,3 +219,15 @@ static constexpr bool digitalPinHasPWM(uint8_t p) {
 } // namespace arduino
 
 #include "portable/teensy.h"
+#include "portable/threaded_irq.h"
+#include "portable/timer.h"
+#include "portable/console.h"
+#include "portable/idle_jobs.h"
+#include "portable/small_alloc.h"
+#include "portable/dma_buffer.h"
+#include "portable/rcu.h"
+#include "portable/token_bucket.h"
+#include "portable/lock_stats.h"
+#if defined __IMXRT1062__
+#include "portable/memcpy_m7.h"
+#endif
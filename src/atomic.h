@@ -33,6 +33,12 @@
  * This file implements atomic functions by disabling interrupts globally.
  * Implementations with architecture specific atomic instructions can be
  * provided under each compiler directory.
+ *
+ * If configUSE_GCC_BUILTIN_ATOMICS is set to 1, the functions are mapped to
+ * the lock-free GCC __atomic builtins instead (LDREX/STREX loops on
+ * Cortex-M3/M4/M7), so no interrupts are masked.  The interrupt masking
+ * implementation is kept as fallback for cores without exclusive access
+ * instructions.
  */
 
 #ifndef ATOMIC_H
@@ -111,23 +117,27 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
                                                             uint32_t ulExchange,
                                                             uint32_t ulComparand )
 {
-    uint32_t ulReturnValue;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_compare_exchange_n( pulDestination, &ulComparand, ulExchange, pdFALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) ? ATOMIC_COMPARE_AND_SWAP_SUCCESS : ATOMIC_COMPARE_AND_SWAP_FAILURE;
+    #else
+        uint32_t ulReturnValue;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        if( *pulDestination == ulComparand )
-        {
-            *pulDestination = ulExchange;
-            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
-        }
-        else
+        ATOMIC_ENTER_CRITICAL();
         {
-            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+            if( *pulDestination == ulComparand )
+            {
+                *pulDestination = ulExchange;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
+            else
+            {
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+            }
         }
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulReturnValue;
+        return ulReturnValue;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 /*-----------------------------------------------------------*/
 
@@ -146,16 +156,20 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
 static portFORCE_INLINE void * Atomic_SwapPointers_p32( void * volatile * ppvDestination,
                                                         void * pvExchange )
 {
-    void * pReturnValue;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_exchange_n( ppvDestination, pvExchange, __ATOMIC_SEQ_CST );
+    #else
+        void * pReturnValue;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        pReturnValue = *ppvDestination;
-        *ppvDestination = pvExchange;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            pReturnValue = *ppvDestination;
+            *ppvDestination = pvExchange;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return pReturnValue;
+        return pReturnValue;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 /*-----------------------------------------------------------*/
 
@@ -179,19 +193,23 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwapPointers_p32( void * volat
                                                                     void * pvExchange,
                                                                     void * pvComparand )
 {
-    uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_compare_exchange_n( ppvDestination, &pvComparand, pvExchange, pdFALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) ? ATOMIC_COMPARE_AND_SWAP_SUCCESS : ATOMIC_COMPARE_AND_SWAP_FAILURE;
+    #else
+        uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        if( *ppvDestination == pvComparand )
+        ATOMIC_ENTER_CRITICAL();
         {
-            *ppvDestination = pvExchange;
-            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            if( *ppvDestination == pvComparand )
+            {
+                *ppvDestination = pvExchange;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
         }
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulReturnValue;
+        return ulReturnValue;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 
 
@@ -211,16 +229,20 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwapPointers_p32( void * volat
 static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
                                                  uint32_t ulCount )
 {
-    uint32_t ulCurrent;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_fetch_add( pulAddend, ulCount, __ATOMIC_SEQ_CST );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulAddend;
-        *pulAddend += ulCount;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend += ulCount;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 /*-----------------------------------------------------------*/
 
@@ -239,16 +261,20 @@ static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
 static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAddend,
                                                       uint32_t ulCount )
 {
-    uint32_t ulCurrent;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_fetch_sub( pulAddend, ulCount, __ATOMIC_SEQ_CST );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulAddend;
-        *pulAddend -= ulCount;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend -= ulCount;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 /*-----------------------------------------------------------*/
 
@@ -264,16 +290,20 @@ static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAdd
  */
 static portFORCE_INLINE uint32_t Atomic_Increment_u32( uint32_t volatile * pulAddend )
 {
-    uint32_t ulCurrent;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_fetch_add( pulAddend, 1U, __ATOMIC_SEQ_CST );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulAddend;
-        *pulAddend += 1;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend += 1;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 /*-----------------------------------------------------------*/
 
@@ -289,16 +319,20 @@ static portFORCE_INLINE uint32_t Atomic_Increment_u32( uint32_t volatile * pulAd
  */
 static portFORCE_INLINE uint32_t Atomic_Decrement_u32( uint32_t volatile * pulAddend )
 {
-    uint32_t ulCurrent;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_fetch_sub( pulAddend, 1U, __ATOMIC_SEQ_CST );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulAddend;
-        *pulAddend -= 1;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend -= 1;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 
 /*----------------------------- Bitwise Logical ------------------------------*/
@@ -317,16 +351,20 @@ static portFORCE_INLINE uint32_t Atomic_Decrement_u32( uint32_t volatile * pulAd
 static portFORCE_INLINE uint32_t Atomic_OR_u32( uint32_t volatile * pulDestination,
                                                 uint32_t ulValue )
 {
-    uint32_t ulCurrent;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_fetch_or( pulDestination, ulValue, __ATOMIC_SEQ_CST );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulDestination;
-        *pulDestination |= ulValue;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination |= ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 /*-----------------------------------------------------------*/
 
@@ -344,16 +382,20 @@ static portFORCE_INLINE uint32_t Atomic_OR_u32( uint32_t volatile * pulDestinati
 static portFORCE_INLINE uint32_t Atomic_AND_u32( uint32_t volatile * pulDestination,
                                                  uint32_t ulValue )
 {
-    uint32_t ulCurrent;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_fetch_and( pulDestination, ulValue, __ATOMIC_SEQ_CST );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulDestination;
-        *pulDestination &= ulValue;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination &= ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 /*-----------------------------------------------------------*/
 
@@ -371,16 +413,20 @@ static portFORCE_INLINE uint32_t Atomic_AND_u32( uint32_t volatile * pulDestinat
 static portFORCE_INLINE uint32_t Atomic_NAND_u32( uint32_t volatile * pulDestination,
                                                   uint32_t ulValue )
 {
-    uint32_t ulCurrent;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_fetch_nand( pulDestination, ulValue, __ATOMIC_SEQ_CST );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulDestination;
-        *pulDestination = ~( ulCurrent & ulValue );
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination = ~( ulCurrent & ulValue );
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 /*-----------------------------------------------------------*/
 
@@ -398,16 +444,20 @@ static portFORCE_INLINE uint32_t Atomic_NAND_u32( uint32_t volatile * pulDestina
 static portFORCE_INLINE uint32_t Atomic_XOR_u32( uint32_t volatile * pulDestination,
                                                  uint32_t ulValue )
 {
-    uint32_t ulCurrent;
+    #if ( configUSE_GCC_BUILTIN_ATOMICS == 1 )
+        return __atomic_fetch_xor( pulDestination, ulValue, __ATOMIC_SEQ_CST );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulDestination;
-        *pulDestination ^= ulValue;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination ^= ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif /* configUSE_GCC_BUILTIN_ATOMICS */
 }
 
 /* *INDENT-OFF* */
@@ -0,0 +1,555 @@
+/*
+ * FreeRTOS Kernel V11.0.1 rendezvous channels
+ * Copyright (C) 2026 Timo Sandmann.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file    channel.c
+ * @brief   Synchronous (zero capacity) channels for FreeRTOS
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "channel.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_CHANNELS == 1 )
+
+/*
+ * All accesses to a channel are made with the scheduler suspended, channels
+ * are not used from ISRs.  Items are copied using the handoff buffers of the
+ * tasks, see vTaskSetHandoffBuffer().
+ */
+typedef struct ChannelDef_t
+{
+    List_t xTasksWaitingToSend;    /**< Senders blocked until a receiver takes their item, in priority order. */
+    List_t xTasksWaitingToReceive; /**< Receivers blocked in xChannelReceive() until a sender arrives, in priority order. */
+    List_t * pxSelectList;         /**< Event list of the task blocked in xChannelReceiveSelect() on this channel, NULL if none. */
+    UBaseType_t uxItemSize;
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the channel is statically allocated to ensure no attempt is made to free the memory. */
+    #endif
+} Channel_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseChannel( Channel_t * const pxChannel,
+                                  const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy pvItem into the buffer of the highest priority task waiting to receive
+ * from the channel (in xChannelReceive() or xChannelReceiveSelect()) and
+ * unblock it.  Returns pdFALSE if no receiver is waiting.
+ */
+static BaseType_t prvGiveToReceiver( Channel_t * const pxChannel,
+                                     const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy the item of the highest priority task waiting to send to the channel
+ * into pvBuffer and unblock the sender.  Returns pdFALSE if no sender is
+ * waiting.
+ */
+static BaseType_t prvTakeFromSender( Channel_t * const pxChannel,
+                                     void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    ChannelHandle_t xChannelCreateStatic( UBaseType_t uxItemSize,
+                                          StaticChannel_t * pxChannelBuffer )
+    {
+        Channel_t * pxChannel;
+
+        configASSERT( pxChannelBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticChannel_t equals the size of the real
+             * channel structure. */
+            volatile size_t xSize = sizeof( StaticChannel_t );
+            configASSERT( xSize == sizeof( Channel_t ) );
+        }
+        #endif /* configASSERT_DEFINED */
+
+        /* The user has provided a statically allocated channel - use it. */
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        pxChannel = ( Channel_t * ) pxChannelBuffer;
+
+        prvInitialiseChannel( pxChannel, uxItemSize );
+
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both static and dynamic allocation can be used, so note that
+             * this channel was created statically in case it is later
+             * deleted. */
+            pxChannel->ucStaticallyAllocated = pdTRUE;
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+        return pxChannel;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    ChannelHandle_t xChannelCreate( UBaseType_t uxItemSize )
+    {
+        Channel_t * pxChannel;
+
+        /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxChannel = ( Channel_t * ) pvPortMalloc( sizeof( Channel_t ) );
+
+        if( pxChannel != NULL )
+        {
+            prvInitialiseChannel( pxChannel, uxItemSize );
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                /* Both static and dynamic allocation can be used, so note this
+                 * channel was allocated dynamically in case it is later
+                 * deleted. */
+                pxChannel->ucStaticallyAllocated = pdFALSE;
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxChannel;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vChannelDelete( ChannelHandle_t xChannel )
+{
+    Channel_t * const pxChannel = xChannel;
+
+    configASSERT( pxChannel );
+
+    /* A blocked task would access the channel after it was freed. */
+    configASSERT( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToSend ) ) != pdFALSE );
+    configASSERT( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToReceive ) ) != pdFALSE );
+    configASSERT( pxChannel->pxSelectList == NULL );
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The channel can only have been allocated dynamically - free it
+         * again. */
+        vPortFree( pxChannel );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The channel could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxChannel->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxChannel );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xChannelSend( ChannelHandle_t xChannel,
+                         const void * pvItem,
+                         TickType_t xTicksToWait )
+{
+    Channel_t * const pxChannel = xChannel;
+    BaseType_t xReturn = pdFAIL, xBlocked = pdFALSE, xAlreadyYielded;
+
+    configASSERT( pxChannel );
+    configASSERT( pvItem );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    vTaskSuspendAll();
+    {
+        if( prvGiveToReceiver( pxChannel, pvItem ) != pdFALSE )
+        {
+            xReturn = pdPASS;
+        }
+        else if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Wait for a receiver to copy the item straight from pvItem. */
+            vTaskSetHandoffBuffer( ( void * ) pvItem );
+            vTaskSetBlockedOn( ( void * ) pxChannel, eBlockedOnChannel );
+            vTaskPlaceOnEventList( &( pxChannel->xTasksWaitingToSend ), xTicksToWait );
+
+            /* A task selecting on this channel must poll it again. */
+            if( ( pxChannel->pxSelectList != NULL ) && ( listLIST_IS_EMPTY( pxChannel->pxSelectList ) == pdFALSE ) )
+            {
+                ( void ) xTaskRemoveFromEventList( pxChannel->pxSelectList );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xBlocked = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    xAlreadyYielded = xTaskResumeAll();
+
+    if( xBlocked != pdFALSE )
+    {
+        if( xAlreadyYielded == pdFALSE )
+        {
+            taskYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Either a receiver took the item or the block time expired. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = ( xTaskResetHandoffState() != pdFALSE ) ? pdPASS : pdFAIL;
+        }
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xChannelReceive( ChannelHandle_t xChannel,
+                            void * pvBuffer,
+                            TickType_t xTicksToWait )
+{
+    Channel_t * const pxChannel = xChannel;
+    BaseType_t xReturn = pdFAIL, xBlocked = pdFALSE, xAlreadyYielded;
+
+    configASSERT( pxChannel );
+    configASSERT( pvBuffer );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    vTaskSuspendAll();
+    {
+        if( prvTakeFromSender( pxChannel, pvBuffer ) != pdFALSE )
+        {
+            xReturn = pdPASS;
+        }
+        else if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Wait for a sender to copy its item straight into pvBuffer. */
+            vTaskSetHandoffBuffer( pvBuffer );
+            vTaskSetBlockedOn( ( void * ) pxChannel, eBlockedOnChannel );
+            vTaskPlaceOnEventList( &( pxChannel->xTasksWaitingToReceive ), xTicksToWait );
+            xBlocked = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    xAlreadyYielded = xTaskResumeAll();
+
+    if( xBlocked != pdFALSE )
+    {
+        if( xAlreadyYielded == pdFALSE )
+        {
+            taskYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Either a sender delivered an item or the block time expired. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = ( xTaskResetHandoffState() != pdFALSE ) ? pdPASS : pdFAIL;
+        }
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xChannelReceiveSelect( const ChannelHandle_t * pxChannels,
+                                  UBaseType_t uxNumChannels,
+                                  void * pvBuffer,
+                                  TickType_t xTicksToWait )
+{
+    List_t xSelectList;
+    TimeOut_t xTimeOut;
+    BaseType_t xReturn, xBlocked, xAlreadyYielded, xDelivered;
+    UBaseType_t x, uxHighestPriorityChannel;
+    TickType_t xHighestPriorityValue;
+
+    configASSERT( pxChannels );
+    configASSERT( uxNumChannels > ( UBaseType_t ) 0U );
+    configASSERT( pvBuffer );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /* The task blocks on this list, which is referenced by all the channels
+     * while the task is blocked. */
+    vListInitialise( &xSelectList );
+    vTaskSetTimeOutState( &xTimeOut );
+
+    do
+    {
+        xReturn = channelSELECT_TIMEOUT;
+        xBlocked = pdFALSE;
+
+        vTaskSuspendAll();
+        {
+            /* Serve the highest priority waiting sender.  The item value of an
+             * event list item is configMAX_PRIORITIES minus the priority of the
+             * task, so lower values are higher priorities. */
+            uxHighestPriorityChannel = uxNumChannels;
+            xHighestPriorityValue = portMAX_DELAY;
+
+            for( x = ( UBaseType_t ) 0U; x < uxNumChannels; x++ )
+            {
+                const List_t * const pxSenders = &( pxChannels[ x ]->xTasksWaitingToSend );
+
+                if( ( listLIST_IS_EMPTY( pxSenders ) == pdFALSE ) && ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxSenders ) < xHighestPriorityValue ) )
+                {
+                    xHighestPriorityValue = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxSenders );
+                    uxHighestPriorityChannel = x;
+                }
+            }
+
+            if( ( uxHighestPriorityChannel < uxNumChannels ) && ( prvTakeFromSender( pxChannels[ uxHighestPriorityChannel ], pvBuffer ) != pdFALSE ) )
+            {
+                xReturn = ( BaseType_t ) uxHighestPriorityChannel;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                for( x = ( UBaseType_t ) 0U; x < uxNumChannels; x++ )
+                {
+                    /* Only one task can select on a channel at a time. */
+                    configASSERT( pxChannels[ x ]->pxSelectList == NULL );
+                    pxChannels[ x ]->pxSelectList = &xSelectList;
+                }
+
+                /* A sender may copy its item straight into pvBuffer. */
+                vTaskSetHandoffBuffer( pvBuffer );
+                vTaskSetBlockedOn( NULL, eBlockedOnChannel );
+                vTaskPlaceOnEventList( &xSelectList, xTicksToWait );
+                xBlocked = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        xAlreadyYielded = xTaskResumeAll();
+
+        if( xBlocked != pdFALSE )
+        {
+            if( xAlreadyYielded == pdFALSE )
+            {
+                taskYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            vTaskSuspendAll();
+            {
+                taskENTER_CRITICAL();
+                {
+                    xDelivered = xTaskResetHandoffState();
+                }
+                taskEXIT_CRITICAL();
+
+                for( x = ( UBaseType_t ) 0U; x < uxNumChannels; x++ )
+                {
+                    if( pxChannels[ x ]->pxSelectList == NULL )
+                    {
+                        /* Cleared by the sender that delivered the item. */
+                        xReturn = ( BaseType_t ) x;
+                    }
+                    else
+                    {
+                        pxChannels[ x ]->pxSelectList = NULL;
+                    }
+                }
+
+                configASSERT( ( xDelivered != pdFALSE ) == ( xReturn != channelSELECT_TIMEOUT ) );
+                ( void ) xDelivered;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* If the task was unblocked without an item (a sender that was not
+         * able to hand off its item, or the block time expired), poll the
+         * channels again. */
+    } while( ( xBlocked != pdFALSE ) && ( xReturn == channelSELECT_TIMEOUT ) );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseChannel( Channel_t * const pxChannel,
+                                  const UBaseType_t uxItemSize )
+{
+    configASSERT( uxItemSize > ( UBaseType_t ) 0U );
+
+    vListInitialise( &( pxChannel->xTasksWaitingToSend ) );
+    vListInitialise( &( pxChannel->xTasksWaitingToReceive ) );
+    pxChannel->pxSelectList = NULL;
+    pxChannel->uxItemSize = uxItemSize;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvGiveToReceiver( Channel_t * const pxChannel,
+                                     const void * pvItem )
+{
+    List_t * pxReceivers = &( pxChannel->xTasksWaitingToReceive );
+    List_t * const pxSelectList = pxChannel->pxSelectList;
+    void * pvBuffer;
+    BaseType_t xReturn = pdFALSE;
+
+    /* A selecting task competes with the tasks blocked in xChannelReceive(),
+     * the higher priority one gets the item. */
+    if( ( pxSelectList != NULL ) && ( listLIST_IS_EMPTY( pxSelectList ) == pdFALSE ) )
+    {
+        if( ( listLIST_IS_EMPTY( pxReceivers ) != pdFALSE ) || ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxSelectList ) < listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxReceivers ) ) )
+        {
+            pxReceivers = pxSelectList;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pvBuffer = pvTaskTakeHandoffBuffer( pxReceivers );
+
+    if( pvBuffer != NULL )
+    {
+        ( void ) portMEMCPY( pvBuffer, pvItem, ( size_t ) pxChannel->uxItemSize );
+        ( void ) xTaskRemoveFromEventList( pxReceivers );
+
+        if( pxReceivers == pxSelectList )
+        {
+            /* Tells the selecting task which channel delivered the item. */
+            pxChannel->pxSelectList = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeFromSender( Channel_t * const pxChannel,
+                                     void * pvBuffer )
+{
+    const void * const pvItem = pvTaskTakeHandoffBuffer( &( pxChannel->xTasksWaitingToSend ) );
+    BaseType_t xReturn = pdFALSE;
+
+    if( pvItem != NULL )
+    {
+        /* The sender is blocked, so its buffer is still valid. */
+        ( void ) portMEMCPY( pvBuffer, pvItem, ( size_t ) pxChannel->uxItemSize );
+        ( void ) xTaskRemoveFromEventList( &( pxChannel->xTasksWaitingToSend ) );
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_CHANNELS */
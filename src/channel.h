@@ -0,0 +1,174 @@
+/*
+ * FreeRTOS Kernel V11.0.1 rendezvous channels
+ * Copyright (C) 2026 Timo Sandmann.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file    channel.h
+ * @brief   Synchronous (zero capacity) channels for FreeRTOS
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#ifndef INC_CHANNEL_H
+#define INC_CHANNEL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include channel.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A channel has no storage.  xChannelSend() blocks until a receiver takes the
+ * item, which is copied directly from the buffer of the sending task into the
+ * buffer of the receiving task.  Waiting senders and receivers are paired in
+ * priority order.  Channels must not be used from ISRs.
+ */
+struct ChannelDef_t;
+typedef struct ChannelDef_t * ChannelHandle_t;
+
+/*
+ * Same size and alignment as the (hidden) channel structure, used to create a
+ * channel without dynamic memory allocation.
+ */
+typedef struct xSTATIC_CHANNEL
+{
+    StaticList_t xDummy1[ 2 ];
+    void * pvDummy2;
+    UBaseType_t uxDummy3;
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy4;
+    #endif
+} StaticChannel_t;
+
+/* Returned by xChannelReceiveSelect() if no item was received. */
+#define channelSELECT_TIMEOUT    ( ( BaseType_t ) -1 )
+
+/**
+ * channel. h
+ * @code{c}
+ * ChannelHandle_t xChannelCreate( UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Create a new channel for items of uxItemSize bytes.
+ *
+ * @param uxItemSize The number of bytes copied from the sender to the receiver
+ * for each item.
+ *
+ * @return The handle of the channel, or NULL if it could not be allocated.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    ChannelHandle_t xChannelCreate( UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * channel. h
+ * @code{c}
+ * ChannelHandle_t xChannelCreateStatic( UBaseType_t uxItemSize, StaticChannel_t *pxChannelBuffer );
+ * @endcode
+ *
+ * Create a new channel using the memory pointed to by pxChannelBuffer.
+ *
+ * @return The handle of the channel.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    ChannelHandle_t xChannelCreateStatic( UBaseType_t uxItemSize,
+                                          StaticChannel_t * pxChannelBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * channel. h
+ * @code{c}
+ * void vChannelDelete( ChannelHandle_t xChannel );
+ * @endcode
+ *
+ * Delete a channel.  No task may be blocked on the channel.
+ */
+void vChannelDelete( ChannelHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * channel. h
+ * @code{c}
+ * BaseType_t xChannelSend( ChannelHandle_t xChannel, const void *pvItem, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Send an item and wait until a receiver took it.  pvItem must stay valid
+ * until the function returns, so it can live on the stack of the caller.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for a receiver.
+ *
+ * @return pdPASS if a receiver took the item, otherwise pdFAIL.
+ */
+BaseType_t xChannelSend( ChannelHandle_t xChannel,
+                         const void * pvItem,
+                         TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * channel. h
+ * @code{c}
+ * BaseType_t xChannelReceive( ChannelHandle_t xChannel, void *pvBuffer, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receive an item, waiting for a sender if there is none.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for a sender.
+ *
+ * @return pdPASS if an item was copied into pvBuffer, otherwise pdFAIL.
+ */
+BaseType_t xChannelReceive( ChannelHandle_t xChannel,
+                            void * pvBuffer,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * channel. h
+ * @code{c}
+ * BaseType_t xChannelReceiveSelect( const ChannelHandle_t *pxChannels, UBaseType_t uxNumChannels, void *pvBuffer, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receive an item from whichever of the channels has a sender first.  If
+ * senders are waiting on several channels, the highest priority sender is
+ * served.  Only one task at a time can select on a channel, and that task must
+ * not be deleted while it is blocked in this function.
+ *
+ * @param pvBuffer Must be large enough for the largest item size of the
+ * channels.
+ *
+ * @return The index of the channel in pxChannels the item was received from,
+ * or channelSELECT_TIMEOUT if no sender arrived within xTicksToWait ticks.
+ */
+BaseType_t xChannelReceiveSelect( const ChannelHandle_t * pxChannels,
+                                  UBaseType_t uxNumChannels,
+                                  void * pvBuffer,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* INC_CHANNEL_H */
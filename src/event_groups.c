@@ -222,6 +222,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
+                vTaskSetBlockedOn( ( void * ) pxEventBits, eBlockedOnEventGroup );
                 vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                 /* This assignment is obsolete as uxReturn will get set after
@@ -385,6 +386,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             /* Store the bits that the calling task is waiting for in the
              * task's event list item so the kernel knows when a match is
              * found.  Then enter the blocked state. */
+            vTaskSetBlockedOn( ( void * ) pxEventBits, eBlockedOnEventGroup );
             vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
             /* This is obsolete as it will get set after the task unblocks, but
@@ -0,0 +1,490 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    console.cpp
+ * @brief   Diagnostic console task for a running system
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "console.h"
+#include "arduino_freertos.h"
+#include "avr/pgmspace.h"
+
+#include <cinttypes>
+#include <cstring>
+#include <cstdlib>
+#include <iterator>
+#include <tuple>
+
+
+#if configUSE_SWITCH_TRACE == 1
+extern "C" {
+volatile uint8_t freertos_switch_trace_enabled;
+}
+#endif
+
+namespace freertos {
+namespace {
+static constexpr size_t MAX_TASKS { 24 };
+static constexpr size_t MAX_COMMANDS { 16 };
+static constexpr size_t MAX_THREADED_IRQS { 16 };
+static constexpr size_t LINE_LENGTH { 64 };
+
+struct command_entry {
+    const char* name;
+    const char* help;
+    console_command_t command;
+};
+
+/* only used by the console task, so the commands don't need large stacks */
+TaskStatus_t g_tasks[MAX_TASKS];
+TaskStatus_t g_tasks_previous[MAX_TASKS];
+
+uint32_t parse_ms(const char* args, const uint32_t default_ms, const uint32_t max_ms) {
+    const uint32_t ms { *args ? static_cast<uint32_t>(std::strtoul(args, nullptr, 10)) : default_ms };
+    return ms < 10 ? 10 : (ms > max_ms ? max_ms : ms);
+}
+
+char state_char(const eTaskState state) {
+    switch (state) {
+        case eRunning: return 'X';
+        case eReady: return 'R';
+        case eBlocked: return 'B';
+        case eSuspended: return 'S';
+        case eDeleted: return 'D';
+        default: return '?';
+    }
+}
+
+const TaskStatus_t* find_task(const TaskStatus_t* p_tasks, const UBaseType_t num, const TaskHandle_t handle, const UBaseType_t number) {
+    for (UBaseType_t i {}; i < num; ++i) {
+        if (p_tasks[i].xHandle == handle && p_tasks[i].xTaskNumber == number) {
+            return &p_tasks[i];
+        }
+    }
+    return nullptr;
+}
+
+void cmd_help(Stream& io, const char*);
+
+FLASHMEM void cmd_tasks(Stream& io, const char*) {
+    configRUN_TIME_COUNTER_TYPE total;
+    const UBaseType_t num { ::uxTaskGetSystemState(g_tasks, MAX_TASKS, &total) };
+    if (!num) {
+        io.printf(PSTR("more than %u tasks\r\n"), MAX_TASKS);
+        return;
+    }
+
+    io.printf(PSTR("%-*s st prio base stack free   runtime ms\r\n"), configMAX_TASK_NAME_LEN, PSTR("name"));
+    for (UBaseType_t i {}; i < num; ++i) {
+        const TaskStatus_t& task { g_tasks[i] };
+        io.printf(PSTR("%-*s %c  %4lu %4lu %10u %12" PRIu32 "\r\n"), configMAX_TASK_NAME_LEN, task.pcTaskName, state_char(task.eCurrentState),
+            task.uxCurrentPriority, task.uxBasePriority, task.usStackHighWaterMark * sizeof(StackType_t),
+            static_cast<uint32_t>(task.ulRunTimeCounter / 1'000UL));
+    }
+}
+
+FLASHMEM void cmd_top(Stream& io, const char* args) {
+    const uint32_t interval_ms { parse_ms(args, 1'000, 60'000) };
+
+    configRUN_TIME_COUNTER_TYPE total_previous, total;
+    const UBaseType_t num_previous { ::uxTaskGetSystemState(g_tasks_previous, MAX_TASKS, &total_previous) };
+    ::vTaskDelay(pdMS_TO_TICKS(interval_ms));
+    const UBaseType_t num { ::uxTaskGetSystemState(g_tasks, MAX_TASKS, &total) };
+    if (!num_previous || !num) {
+        io.printf(PSTR("more than %u tasks\r\n"), MAX_TASKS);
+        return;
+    }
+
+    const uint64_t elapsed { total - total_previous ? total - total_previous : 1 };
+    io.printf(PSTR("%-*s prio    cpu\r\n"), configMAX_TASK_NAME_LEN, PSTR("name"));
+    for (UBaseType_t i {}; i < num; ++i) {
+        const TaskStatus_t& task { g_tasks[i] };
+        const TaskStatus_t* p_previous { find_task(g_tasks_previous, num_previous, task.xHandle, task.xTaskNumber) };
+        const configRUN_TIME_COUNTER_TYPE runtime { task.ulRunTimeCounter - (p_previous ? p_previous->ulRunTimeCounter : 0) };
+        const uint32_t permille { static_cast<uint32_t>(runtime * 1'000ULL / elapsed) };
+        io.printf(PSTR("%-*s %4lu %3" PRIu32 ".%" PRIu32 " %%\r\n"), configMAX_TASK_NAME_LEN, task.pcTaskName, task.uxCurrentPriority, permille / 10, permille % 10);
+    }
+}
+
+FLASHMEM void cmd_heap(Stream& io, const char*) {
+    const auto info1 { ram1_usage() };
+    const auto info2 { ram2_usage() };
+    const auto info3 { ram3_usage() };
+
+    io.printf(PSTR("RAM1 size: %u, free: %u, data: %u, bss: %u, heap used: %u, system free: %u\r\n"), std::get<6>(info1), std::get<0>(info1),
+        std::get<1>(info1), std::get<2>(info1), std::get<3>(info1), std::get<4>(info1));
+    if (std::get<1>(info2)) {
+        io.printf(PSTR("RAM2 size: %u, free: %u, used: %u\r\n"), std::get<1>(info2), std::get<0>(info2), std::get<1>(info2) - std::get<0>(info2));
+    }
+    if (std::get<1>(info3)) {
+        io.printf(PSTR("EXTMEM size: %u, free: %u, used: %u\r\n"), std::get<1>(info3), std::get<0>(info3), std::get<1>(info3) - std::get<0>(info3));
+    }
+    io.printf(PSTR("heap free (newlib): %u\r\n"), ::xPortGetFreeHeapSize());
+}
+
+/* load of the threaded interrupts, other vectors are not instrumented */
+FLASHMEM void cmd_irq(Stream& io, const char* args) {
+    const uint32_t interval_ms { parse_ms(args, 1'000, 5'000) }; // cycle counter wraps after 7 s at 600 MHz
+
+    struct sample {
+        uint8_t irq;
+        uint32_t count;
+        uint64_t runtime;
+    };
+    static sample samples[MAX_THREADED_IRQS];
+
+    size_t num {};
+    for (uint16_t irq {}; irq < NVIC_NUM_INTERRUPTS && num < MAX_THREADED_IRQS; ++irq) {
+        threaded_irq_stats stats;
+        if (get_threaded_irq_stats(irq, stats)) {
+            samples[num++] = { static_cast<uint8_t>(irq), stats.count, stats.total_runtime };
+        }
+    }
+    if (!num) {
+        io.println(PSTR("no threaded interrupts"));
+        return;
+    }
+
+    const uint32_t start { ARM_DWT_CYCCNT };
+    ::vTaskDelay(pdMS_TO_TICKS(interval_ms));
+    const uint32_t elapsed { ARM_DWT_CYCCNT - start };
+
+    io.println(PSTR("irq     calls/s   load  max latency  max runtime (cycles)"));
+    for (size_t i {}; i < num; ++i) {
+        threaded_irq_stats stats;
+        if (!get_threaded_irq_stats(samples[i].irq, stats)) {
+            continue;
+        }
+        const uint32_t calls { static_cast<uint32_t>((stats.count - samples[i].count) * 1'000ULL / interval_ms) };
+        const uint32_t permille { static_cast<uint32_t>((stats.total_runtime - samples[i].runtime) * 1'000ULL / elapsed) };
+        io.printf(PSTR("%3u %11" PRIu32 " %3" PRIu32 ".%" PRIu32 " %% %12" PRIu32 " %12" PRIu32 "\r\n"), samples[i].irq, calls, permille / 10, permille % 10, stats.max_latency, stats.max_runtime);
+    }
+}
+
+#if configUSE_IDLE_HOOK == 1
+FLASHMEM void cmd_jobs(Stream& io, const char*) {
+    io.println(PSTR("job           steps  preempted  runtime (kcycles)  max runtime (cycles)"));
+    for (int8_t job {}; job < MAX_IDLE_JOBS; ++job) {
+        idle_job_stats stats;
+        if (get_idle_job_stats(job, stats)) {
+            io.printf(PSTR("%-8s %10" PRIu32 " %10" PRIu32 " %18" PRIu32 " %20" PRIu32 "\r\n"), stats.name, stats.steps, stats.preempted, static_cast<uint32_t>(stats.total_runtime / 1'000),
+                stats.max_runtime);
+        }
+    }
+}
+#endif // configUSE_IDLE_HOOK
+
+#if configUSE_SMALL_OBJECT_ALLOCATOR == 1
+FLASHMEM void cmd_alloc(Stream& io, const char*) {
+    io.println(PSTR("size pages     allocs      frees    refills    flushes  fallbacks"));
+    for (uint8_t size_class {}; size_class < SMALL_ALLOC_CLASSES; ++size_class) {
+        small_alloc_stats stats;
+        if (get_small_alloc_stats(size_class, stats)) {
+            io.printf(PSTR("%4u %5u %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 "\r\n"), stats.size, stats.pages, stats.allocs, stats.frees, stats.refills, stats.flushes,
+                stats.fallbacks);
+        }
+    }
+}
+#endif // configUSE_SMALL_OBJECT_ALLOCATOR
+
+#if configUSE_TASK_STATE_STATS == 1
+TaskHandle_t g_handles[MAX_TASKS];
+
+const char* blocked_on_name(const eBlockedOnType type) {
+    switch (type) {
+        case eBlockedOnDelay: return PSTR("delay");
+        case eBlockedOnNotification: return PSTR("notify");
+        case eBlockedOnQueue: return PSTR("queue");
+        case eBlockedOnSemaphore: return PSTR("sem");
+        case eBlockedOnMutex: return PSTR("mutex");
+        case eBlockedOnEventGroup: return PSTR("events");
+        case eBlockedOnStreamBuffer: return PSTR("stream");
+        case eBlockedOnChannel: return PSTR("chan");
+        default: return PSTR("-");
+    }
+}
+
+/* upper bound of the histogram bucket reaching permille of all samples */
+uint32_t latency_percentile(const TaskStateStats_t& stats, const uint32_t permille) {
+    uint64_t total {};
+    for (const auto count : stats.ulReadyLatency) {
+        total += count;
+    }
+
+    uint64_t sum {};
+    for (uint8_t i {}; total && i < configREADY_LATENCY_BUCKETS; ++i) {
+        sum += stats.ulReadyLatency[i];
+        if (sum * 1'000 >= total * permille) {
+            return 1UL << i;
+        }
+    }
+    return 0;
+}
+
+FLASHMEM void cmd_states(Stream& io, const char*) {
+    const UBaseType_t num { ::uxTaskGetSystemState(g_tasks, MAX_TASKS, nullptr) };
+    if (!num) {
+        io.printf(PSTR("more than %u tasks\r\n"), MAX_TASKS);
+        return;
+    }
+
+    io.printf(PSTR("%-*s on     object       run ms   ready ms blocked ms    susp ms  p50 us  p99 us\r\n"), configMAX_TASK_NAME_LEN, PSTR("name"));
+    for (UBaseType_t i {}; i < num; ++i) {
+        const TaskStatus_t& task { g_tasks[i] };
+        TaskStateStats_t stats;
+
+        /* the task may have been deleted in the meantime */
+        bool found {};
+        ::vTaskSuspendAll();
+        const UBaseType_t num_handles { ::uxTaskGetTaskHandles(g_handles, MAX_TASKS) };
+        for (UBaseType_t j {}; j < num_handles && !found; ++j) {
+            found = g_handles[j] == task.xHandle;
+        }
+        if (found) {
+            ::xTaskGetStateStats(task.xHandle, &stats);
+        }
+        ::xTaskResumeAll();
+        if (!found) {
+            continue;
+        }
+
+        configRUN_TIME_COUNTER_TYPE blocked {};
+        for (const auto time : stats.ulBlockedTime) {
+            blocked += time;
+        }
+        io.printf(PSTR("%-*s %-6s %08x %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %7" PRIu32 " %7" PRIu32 "\r\n"), configMAX_TASK_NAME_LEN, task.pcTaskName, blocked_on_name(stats.eBlockedOn),
+            reinterpret_cast<uintptr_t>(stats.pvBlockedOn), static_cast<uint32_t>(stats.ulRunningTime / 1'000UL),
+            static_cast<uint32_t>(stats.ulReadyTime / 1'000UL), static_cast<uint32_t>(blocked / 1'000UL), static_cast<uint32_t>(stats.ulSuspendedTime / 1'000UL),
+            latency_percentile(stats, 500), latency_percentile(stats, 990));
+    }
+}
+#endif // configUSE_TASK_STATE_STATS
+
+#if configUSE_LOCK_STATS == 1
+static constexpr size_t MAX_LOCKS { 16 };
+static constexpr size_t MAX_LOCK_CALLSITES { 3 }; /**< Callsites shown per lock */
+
+lock_stats g_lock_stats[MAX_LOCKS];
+lock_stats g_site_stats[MAX_LOCK_CALLSITES];
+
+FLASHMEM void cmd_locks(Stream& io, const char* args) {
+    if (std::strcmp(args, PSTR("reset")) == 0) {
+        reset_lock_stats();
+        return;
+    }
+
+    const size_t num { get_lock_stats(g_lock_stats, MAX_LOCKS) };
+    io.println(PSTR("lock/callsite      taken  contended     failed    wait ms  max wait us    hold ms  max hold us"));
+    for (size_t i {}; i < num; ++i) {
+        const lock_stats& lock { g_lock_stats[i] };
+        io.printf(PSTR("%08x   %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %12" PRIu32 " %10" PRIu32 " %12" PRIu32 "\r\n"), reinterpret_cast<uintptr_t>(lock.lock), lock.acquisitions, lock.contentions,
+            lock.failures, static_cast<uint32_t>(lock.total_wait_us / 1'000UL), lock.max_wait_us, static_cast<uint32_t>(lock.total_hold_us / 1'000UL),
+            lock.max_hold_us);
+
+        const size_t num_sites { get_lock_stats(g_site_stats, MAX_LOCK_CALLSITES, lock.lock) };
+        for (size_t j {}; j < num_sites; ++j) {
+            const lock_stats& site { g_site_stats[j] };
+            io.printf(PSTR("  %08x %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %12" PRIu32 " %10" PRIu32 " %12" PRIu32 "\r\n"), reinterpret_cast<uintptr_t>(site.callsite), site.acquisitions,
+                site.contentions, site.failures, static_cast<uint32_t>(site.total_wait_us / 1'000UL), site.max_wait_us,
+                static_cast<uint32_t>(site.total_hold_us / 1'000UL), site.max_hold_us);
+        }
+    }
+
+    const uint32_t dropped { get_lock_stats_dropped() };
+    if (dropped) {
+        io.printf(PSTR("%" PRIu32 " takes dropped, tables full\r\n"), dropped);
+    }
+}
+#endif // configUSE_LOCK_STATS
+
+#if configUSE_SWITCH_TRACE == 1
+static constexpr uint32_t TRACE_ENTRIES { 256 };
+
+struct trace_entry {
+    uint32_t cycles;
+    void* task;
+};
+
+trace_entry g_trace[TRACE_ENTRIES];
+uint32_t g_trace_pos;
+
+FLASHMEM void cmd_trace(Stream& io, const char* args) {
+    if (std::strcmp(args, PSTR("start")) == 0) {
+        ::freertos_switch_trace_enabled = 0;
+        g_trace_pos = 0;
+        ::freertos_switch_trace_enabled = 1;
+    } else if (std::strcmp(args, PSTR("stop")) == 0) {
+        ::freertos_switch_trace_enabled = 0;
+    } else if (std::strcmp(args, PSTR("dump")) == 0) {
+        ::freertos_switch_trace_enabled = 0;
+
+        configRUN_TIME_COUNTER_TYPE total;
+        const UBaseType_t num_tasks { ::uxTaskGetSystemState(g_tasks, MAX_TASKS, &total) };
+        const uint32_t num { g_trace_pos < TRACE_ENTRIES ? g_trace_pos : TRACE_ENTRIES };
+        uint32_t last { g_trace[(g_trace_pos - num) % TRACE_ENTRIES].cycles };
+
+        io.println(PSTR("    cycles      delta task"));
+        for (uint32_t i { g_trace_pos - num }; i != g_trace_pos; ++i) {
+            const trace_entry& entry { g_trace[i % TRACE_ENTRIES] };
+            const char* name { nullptr };
+            for (UBaseType_t j {}; j < num_tasks; ++j) {
+                if (g_tasks[j].xHandle == entry.task) {
+                    name = g_tasks[j].pcTaskName;
+                    break;
+                }
+            }
+            if (name) {
+                io.printf(PSTR("%10" PRIu32 " %10" PRIu32 " %s\r\n"), entry.cycles, entry.cycles - last, name);
+            } else {
+                io.printf(PSTR("%10" PRIu32 " %10" PRIu32 " <%p>\r\n"), entry.cycles, entry.cycles - last, entry.task);
+            }
+            last = entry.cycles;
+        }
+    } else {
+        io.println(PSTR("usage: trace start|stop|dump"));
+    }
+}
+#endif // configUSE_SWITCH_TRACE
+
+const command_entry BUILTIN_COMMANDS[] {
+    { "help", "list commands", cmd_help },
+    { "tasks", "state, priority, free stack and runtime of all tasks", cmd_tasks },
+    { "top", "[ms] CPU load of all tasks within an interval", cmd_top },
+    { "heap", "memory usage per region", cmd_heap },
+    { "irq", "[ms] load of threaded interrupts within an interval", cmd_irq },
+#if configUSE_IDLE_HOOK == 1
+    { "jobs", "steps and runtime of the idle jobs", cmd_jobs },
+#endif
+#if configUSE_SMALL_OBJECT_ALLOCATOR == 1
+    { "alloc", "statistics of the small object allocator", cmd_alloc },
+#endif
+#if configUSE_TASK_STATE_STATS == 1
+    { "states", "time in state, blocked on object and ready latency of all tasks", cmd_states },
+#endif
+#if configUSE_LOCK_STATS == 1
+    { "locks", "[reset] wait and hold times of mutexes ranked by wait time", cmd_locks },
+#endif
+#if configUSE_SWITCH_TRACE == 1
+    { "trace", "start|stop|dump context switch trace", cmd_trace },
+#endif
+};
+static constexpr size_t NUM_BUILTIN_COMMANDS { std::size(BUILTIN_COMMANDS) };
+static_assert(NUM_BUILTIN_COMMANDS < MAX_COMMANDS, "MAX_COMMANDS too small for the built-in commands");
+
+/* commands added by add_console_command() */
+command_entry g_user_commands[MAX_COMMANDS - NUM_BUILTIN_COMMANDS];
+size_t g_num_user_commands;
+
+inline size_t num_commands() {
+    return NUM_BUILTIN_COMMANDS + g_num_user_commands;
+}
+
+inline const command_entry& get_command(const size_t i) {
+    return i < NUM_BUILTIN_COMMANDS ? BUILTIN_COMMANDS[i] : g_user_commands[i - NUM_BUILTIN_COMMANDS];
+}
+
+FLASHMEM void cmd_help(Stream& io, const char*) {
+    for (size_t i {}; i < num_commands(); ++i) {
+        io.printf(PSTR("%-8s %s\r\n"), get_command(i).name, get_command(i).help);
+    }
+}
+
+void execute(Stream& io, char* line) {
+    char* args { std::strchr(line, ' ') };
+    if (args) {
+        *args++ = 0;
+        while (*args == ' ') {
+            ++args;
+        }
+    } else {
+        args = line + std::strlen(line);
+    }
+
+    for (size_t i {}; i < num_commands(); ++i) {
+        if (std::strcmp(line, get_command(i).name) == 0) {
+            get_command(i).command(io, args);
+            return;
+        }
+    }
+    io.printf(PSTR("unknown command \"%s\", try help\r\n"), line);
+}
+
+void console_task(void* param) {
+    Stream& io { *static_cast<Stream*>(param) };
+    char line[LINE_LENGTH];
+    size_t length {};
+
+    while (true) {
+        while (io.available() > 0) {
+            const int c { io.read() };
+            if (c == '\r' || c == '\n') {
+                if (length) {
+                    line[length] = 0;
+                    length = 0;
+                    execute(io, line);
+                    io.print(PSTR("> "));
+                }
+            } else if ((c == '\b' || c == 0x7f) && length) {
+                --length;
+            } else if (c >= ' ' && length < LINE_LENGTH - 1) {
+                line[length++] = static_cast<char>(c);
+            }
+        }
+
+        ::vTaskDelay(pdMS_TO_TICKS(CONSOLE_POLL_PERIOD_MS));
+    }
+}
+} // namespace
+
+FLASHMEM TaskHandle_t start_console(Stream& io, const uint8_t priority) {
+    TaskHandle_t task {};
+    ::xTaskCreate(console_task, PSTR("CONSOLE"), CONSOLE_TASK_STACK_SIZE, &io, priority, &task);
+    return task;
+}
+
+FLASHMEM TaskHandle_t start_console() {
+    return start_console(::Serial);
+}
+
+bool add_console_command(const char* name, const char* help, console_command_t command) {
+    bool ret { false };
+
+    ::vTaskSuspendAll();
+    if (g_num_user_commands < std::size(g_user_commands)) {
+        g_user_commands[g_num_user_commands++] = { name, help, command };
+        ret = true;
+    }
+    ::xTaskResumeAll();
+
+    return ret;
+}
+} // namespace freertos
+
+#if configUSE_SWITCH_TRACE == 1
+extern "C" {
+/* called by traceTASK_SWITCHED_IN() in the context switch, if enabled */
+FASTRUN void freertos_switch_trace(void* task) {
+    const uint32_t pos { freertos::g_trace_pos };
+    freertos::g_trace[pos % freertos::TRACE_ENTRIES] = { ARM_DWT_CYCCNT, task };
+    freertos::g_trace_pos = pos + 1;
+}
+}
+#endif // configUSE_SWITCH_TRACE
@@ -0,0 +1,65 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    console.h
+ * @brief   Diagnostic console task for a running system
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+
+class Stream;
+typedef struct tskTaskControlBlock* TaskHandle_t;
+
+namespace freertos {
+static constexpr uint16_t CONSOLE_TASK_STACK_SIZE { 768 }; /**< Stack size of the console task in words */
+static constexpr uint8_t CONSOLE_TASK_PRIORITY { 1 };
+static constexpr uint16_t CONSOLE_POLL_PERIOD_MS { 100 }; /**< Period to check the stream for input */
+
+using console_command_t = void (*)(Stream& io, const char* args);
+
+/**
+ * @brief Start the console task, reading commands line by line from a stream
+ * @param[in] io: Stream for commands and output
+ * @param[in] priority: RTOS priority of the console task
+ * @return Handle of the console task or nullptr on error
+ * @note The help command lists the built-in commands enabled by the configuration and the ones added by add_console_command().
+ *       The console uses static buffers only, it polls the stream every CONSOLE_POLL_PERIOD_MS.
+ */
+TaskHandle_t start_console(Stream& io, uint8_t priority = CONSOLE_TASK_PRIORITY);
+
+/**
+ * @brief Start the console task on Serial
+ * @return Handle of the console task or nullptr on error
+ */
+TaskHandle_t start_console();
+
+/**
+ * @brief Add a command to the console
+ * @param[in] name: Name of the command, the string must not be freed
+ * @param[in] help: One line of help text, the string must not be freed
+ * @param[in] command: Function to call with the output stream and the rest of the line
+ * @return true on success, false if the command table is full
+ */
+bool add_console_command(const char* name, const char* help, console_command_t command);
+} // namespace freertos
@@ -0,0 +1,207 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    dma_buffer.cpp
+ * @brief   Cache line aligned buffers for DMA transfers
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#include "dma_buffer.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if defined __IMXRT1062__
+#include "imxrt.h"
+#include "avr/pgmspace.h"
+#endif
+
+
+namespace freertos {
+namespace {
+#if !defined __IMXRT1062__
+/* no data cache on Teensy 3.x and on host builds, the cache maintenance is a no-op */
+inline void arm_dcache_flush(void*, uint32_t) {}
+inline void arm_dcache_delete(void*, uint32_t) {}
+inline void arm_dcache_flush_delete(void*, uint32_t) {}
+#endif
+
+constexpr size_t NUM_SIZE_CLASSES { 8 }; /**< 32 byte to 4 KB */
+static_assert((DMA_CACHE_LINE_SIZE << (NUM_SIZE_CLASSES - 1)) == DMA_PAGE_SIZE, "DMA_PAGE_SIZE must match the largest size class");
+static_assert(DMA_DTCM_POOL_SIZE % DMA_PAGE_SIZE == 0 && DMA_OCRAM_POOL_SIZE % DMA_PAGE_SIZE == 0, "pool sizes must be a multiple of DMA_PAGE_SIZE");
+
+struct free_block {
+    free_block* next;
+};
+
+struct pool {
+    uint8_t* const mem;
+    const uint16_t pages;
+    uint16_t next_page; /**< First page not yet assigned to a size class */
+    uint8_t* const page_class; /**< Size class of each assigned page */
+    free_block* free_list[NUM_SIZE_CLASSES];
+    uint8_t* carve[NUM_SIZE_CLASSES]; /**< Next block never used in the last page of a size class or nullptr */
+};
+
+alignas(DMA_CACHE_LINE_SIZE) uint8_t g_dtcm_mem[DMA_DTCM_POOL_SIZE];
+#if defined __IMXRT1062__
+DMAMEM alignas(DMA_CACHE_LINE_SIZE) uint8_t g_ocram_mem[DMA_OCRAM_POOL_SIZE];
+#else
+alignas(DMA_CACHE_LINE_SIZE) uint8_t g_ocram_mem[DMA_OCRAM_POOL_SIZE];
+#endif
+uint8_t g_dtcm_class[DMA_DTCM_POOL_SIZE / DMA_PAGE_SIZE];
+uint8_t g_ocram_class[DMA_OCRAM_POOL_SIZE / DMA_PAGE_SIZE];
+
+/* indexed by dma_region */
+pool g_pools[] {
+    { g_dtcm_mem, DMA_DTCM_POOL_SIZE / DMA_PAGE_SIZE, 0, g_dtcm_class, {}, {} },
+    { g_ocram_mem, DMA_OCRAM_POOL_SIZE / DMA_PAGE_SIZE, 0, g_ocram_class, {}, {} },
+};
+
+inline size_t size_class(size_t size) {
+    if (size <= DMA_CACHE_LINE_SIZE) {
+        return 0;
+    }
+    return 32 - __builtin_clz(size - 1) - __builtin_ctz(DMA_CACHE_LINE_SIZE);
+}
+
+inline pool* find_pool(const void* ptr) {
+    const auto p_byte { static_cast<const uint8_t*>(ptr) };
+    for (auto& p : g_pools) {
+        if (p_byte >= p.mem && p_byte < p.mem + p.pages * DMA_PAGE_SIZE) {
+            return &p;
+        }
+    }
+    return nullptr;
+}
+
+inline bool line_aligned(const void* ptr, size_t size) {
+    return ((reinterpret_cast<uintptr_t>(ptr) | size) & (DMA_CACHE_LINE_SIZE - 1)) == 0;
+}
+} // namespace
+
+void* dma_alloc(size_t size, dma_region region) {
+    if (size == 0 || size > DMA_PAGE_SIZE) {
+        return nullptr;
+    }
+
+    const size_t cls { size_class(size) };
+    pool& p { g_pools[static_cast<uint8_t>(region)] };
+    void* ptr {};
+
+    const UBaseType_t status { taskENTER_CRITICAL_FROM_ISR() };
+    if (p.free_list[cls]) {
+        ptr = p.free_list[cls];
+        p.free_list[cls] = p.free_list[cls]->next;
+    } else {
+        if (!p.carve[cls] && p.next_page < p.pages) {
+            p.page_class[p.next_page] = static_cast<uint8_t>(cls);
+            p.carve[cls] = p.mem + p.next_page * DMA_PAGE_SIZE;
+            ++p.next_page;
+        }
+        if (p.carve[cls]) {
+            ptr = p.carve[cls];
+            p.carve[cls] += DMA_CACHE_LINE_SIZE << cls;
+            if ((p.carve[cls] - p.mem) % DMA_PAGE_SIZE == 0) {
+                p.carve[cls] = nullptr;
+            }
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+
+    return ptr;
+}
+
+void dma_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    pool* const p_pool { find_pool(ptr) };
+    configASSERT(p_pool);
+    if (!p_pool) {
+        return;
+    }
+
+    const size_t offset { static_cast<size_t>(static_cast<uint8_t*>(ptr) - p_pool->mem) };
+    const uint8_t cls { p_pool->page_class[offset / DMA_PAGE_SIZE] };
+    configASSERT(offset / DMA_PAGE_SIZE < p_pool->next_page && offset % (DMA_CACHE_LINE_SIZE << cls) == 0);
+
+    const UBaseType_t status { taskENTER_CRITICAL_FROM_ISR() };
+    auto p_block { static_cast<free_block*>(ptr) };
+    p_block->next = p_pool->free_list[cls];
+    p_pool->free_list[cls] = p_block;
+    taskEXIT_CRITICAL_FROM_ISR(status);
+}
+
+size_t dma_buffer_size(const void* ptr) {
+    const pool* const p_pool { find_pool(ptr) };
+    if (!p_pool) {
+        return 0;
+    }
+
+    const size_t page { static_cast<size_t>(static_cast<const uint8_t*>(ptr) - p_pool->mem) / DMA_PAGE_SIZE };
+    if (page >= p_pool->next_page) {
+        return 0;
+    }
+    return DMA_CACHE_LINE_SIZE << p_pool->page_class[page];
+}
+
+bool is_cacheable(const void* ptr) {
+#if defined __IMXRT1062__
+    const uintptr_t addr { reinterpret_cast<uintptr_t>(ptr) };
+    /* ITCM and DTCM are not cached, everything else in RAM, flash and EXTMEM is */
+    return !(addr < 0x8'0000U || (addr >= 0x2000'0000U && addr < 0x2008'0000U));
+#else
+    (void) ptr;
+    return false;
+#endif
+}
+
+void prepare_for_device(const void* ptr, size_t size, dma_direction dir) {
+    if (!ptr || !size || !is_cacheable(ptr)) {
+        return;
+    }
+
+    void* const p { const_cast<void*>(ptr) };
+    if (dir == dma_direction::to_device) {
+        arm_dcache_flush(p, size);
+    } else if (dir == dma_direction::from_device && line_aligned(ptr, size)) {
+        /* no dirty line may be evicted over the data written by the device */
+        arm_dcache_delete(p, size);
+    } else {
+        arm_dcache_flush_delete(p, size);
+    }
+}
+
+void prepare_for_cpu(const void* ptr, size_t size, dma_direction dir) {
+    if (!ptr || !size || dir == dma_direction::to_device || !is_cacheable(ptr)) {
+        return;
+    }
+
+    void* const p { const_cast<void*>(ptr) };
+    if (line_aligned(ptr, size)) {
+        arm_dcache_delete(p, size);
+    } else {
+        /* keep data of the partial lines not belonging to the buffer */
+        arm_dcache_flush_delete(p, size);
+    }
+}
+} // namespace freertos
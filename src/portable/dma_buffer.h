@@ -0,0 +1,159 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    dma_buffer.h
+ * @brief   Cache line aligned buffers for DMA transfers
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+
+namespace freertos {
+static constexpr size_t DMA_CACHE_LINE_SIZE { 32 };
+static constexpr size_t DMA_PAGE_SIZE { 4'096 }; /**< Size of the pages the pools are carved from, largest buffer size */
+static constexpr size_t DMA_DTCM_POOL_SIZE { 16 * 1'024 };
+static constexpr size_t DMA_OCRAM_POOL_SIZE { 64 * 1'024 };
+
+/**
+ * @brief Memory region of a DMA buffer
+ */
+enum class dma_region : uint8_t {
+    dtcm, /**< Tightly coupled memory, not cached, fastest for the CPU */
+    ocram, /**< On chip RAM (DMAMEM), cached, buffers need maintenance with prepare_for_device() and prepare_for_cpu() */
+};
+
+/**
+ * @brief Direction of a DMA transfer
+ */
+enum class dma_direction : uint8_t {
+    to_device, /**< Device reads the buffer */
+    from_device, /**< Device writes the buffer */
+    bidirectional,
+};
+
+/**
+ * @brief Allocate a DMA buffer, aligned and padded to whole cache lines
+ * @param[in] size: Size in byte, at most DMA_PAGE_SIZE
+ * @param[in] region: Memory region to allocate from
+ * @return Pointer to the buffer or nullptr if size is invalid or the pool is exhausted
+ * @note O(1), callable from tasks and ISRs. Sizes are rounded up to the next power of two. A page of a pool is assigned to a size class on first
+ *       use and stays in that class.
+ */
+void* dma_alloc(size_t size, dma_region region = dma_region::ocram);
+
+/**
+ * @brief Free a buffer returned by dma_alloc()
+ * @param[in] ptr: Pointer to the buffer, may be nullptr
+ * @note O(1), callable from tasks and ISRs
+ */
+void dma_free(void* ptr);
+
+/**
+ * @brief Get the usable size of a buffer returned by dma_alloc()
+ * @param[in] ptr: Pointer to the buffer
+ * @return Size of the buffer in byte or 0 if ptr is not a DMA buffer
+ */
+size_t dma_buffer_size(const void* ptr);
+
+/**
+ * @brief Check if memory is cached by the CPU
+ * @param[in] ptr: Address to check
+ * @return true for OCRAM, EXTMEM and flash on Teensy 4, false for tightly coupled memory and on boards without data cache
+ */
+bool is_cacheable(const void* ptr);
+
+/**
+ * @brief Cache maintenance before a device accesses the memory
+ * @param[in] ptr: Start of the buffer
+ * @param[in] size: Size of the buffer in byte
+ * @param[in] dir: Direction of the transfer
+ * @note Cleans the cache for to_device, invalidates it for from_device. Buffers not aligned to cache lines are cleaned and invalidated, the CPU
+ *       must not write data sharing a cache line with the buffer until prepare_for_cpu() was called. No-op for memory not cached.
+ */
+void prepare_for_device(const void* ptr, size_t size, dma_direction dir);
+
+/**
+ * @brief Cache maintenance after a device accessed the memory, before the CPU reads it
+ * @param[in] ptr: Start of the buffer
+ * @param[in] size: Size of the buffer in byte
+ * @param[in] dir: Direction of the transfer
+ * @note Invalidates the cache for from_device and bidirectional, removing lines speculatively loaded during the transfer. No-op for memory not
+ *       cached.
+ */
+void prepare_for_cpu(const void* ptr, size_t size, dma_direction dir);
+
+/**
+ * @brief Owning handle of a DMA buffer
+ * @note size() is the padded size of the buffer, so the cache maintenance always covers whole cache lines
+ */
+class dma_buffer {
+    void* ptr_;
+    size_t size_;
+
+public:
+    dma_buffer() noexcept : ptr_ {}, size_ {} {}
+
+    explicit dma_buffer(size_t size, dma_region region = dma_region::ocram) noexcept : ptr_ { dma_alloc(size, region) }, size_ { dma_buffer_size(ptr_) } {}
+
+    dma_buffer(const dma_buffer&) = delete;
+    dma_buffer& operator=(const dma_buffer&) = delete;
+
+    dma_buffer(dma_buffer&& other) noexcept : ptr_ { std::exchange(other.ptr_, nullptr) }, size_ { std::exchange(other.size_, 0) } {}
+
+    dma_buffer& operator=(dma_buffer&& other) noexcept {
+        if (this != &other) {
+            dma_free(ptr_);
+            ptr_ = std::exchange(other.ptr_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~dma_buffer() {
+        dma_free(ptr_);
+    }
+
+    explicit operator bool() const noexcept {
+        return ptr_ != nullptr;
+    }
+
+    uint8_t* data() const noexcept {
+        return static_cast<uint8_t*>(ptr_);
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+    void prepare_for_device(dma_direction dir) const {
+        freertos::prepare_for_device(ptr_, size_, dir);
+    }
+
+    void prepare_for_cpu(dma_direction dir) const {
+        freertos::prepare_for_cpu(ptr_, size_, dir);
+    }
+};
+} // namespace freertos
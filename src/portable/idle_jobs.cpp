@@ -0,0 +1,154 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    idle_jobs.cpp
+ * @brief   Background jobs run in small steps by the idle task
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#include "idle_jobs.h"
+#include "arduino_freertos.h"
+
+
+#if configUSE_IDLE_HOOK == 1
+namespace freertos {
+namespace {
+struct idle_job {
+    idle_job_t step;
+    void* arg;
+    uint32_t budget;
+    idle_job_stats stats;
+};
+
+idle_job g_idle_jobs[MAX_IDLE_JOBS];
+uint8_t g_next_job;
+volatile int8_t g_running_job { -1 };
+
+/* the kernel adds to the run time counter of the idle task whenever it is switched out */
+inline configRUN_TIME_COUNTER_TYPE idle_runtime() {
+#if configGENERATE_RUN_TIME_STATS == 1 && INCLUDE_xTaskGetIdleTaskHandle == 1
+    return ::ulTaskGetIdleRunTimeCounter();
+#else
+    return 0;
+#endif
+}
+} // namespace
+
+int8_t add_idle_job(const char* name, idle_job_t step, void* arg, uint32_t budget) {
+    configASSERT(step);
+
+    int8_t job { -1 };
+    taskENTER_CRITICAL();
+    for (uint8_t i {}; i < MAX_IDLE_JOBS; ++i) {
+        /* the slot of a job just removed may still be in use by the idle task */
+        if (!g_idle_jobs[i].step && i != g_running_job) {
+            g_idle_jobs[i] = { step, arg, budget, { name, 0, 0, 0, 0 } };
+            job = static_cast<int8_t>(i);
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return job;
+}
+
+void remove_idle_job(int8_t job) {
+    if (job < 0 || job >= MAX_IDLE_JOBS) {
+        return;
+    }
+    configASSERT(::xTaskGetCurrentTaskHandle() != ::xTaskGetIdleTaskHandle());
+
+    taskENTER_CRITICAL();
+    g_idle_jobs[job].step = nullptr;
+    taskEXIT_CRITICAL();
+
+    while (g_running_job == job) {
+        ::vTaskDelay(1);
+    }
+}
+
+bool get_idle_job_stats(int8_t job, idle_job_stats& stats) {
+    if (job < 0 || job >= MAX_IDLE_JOBS) {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    const bool valid { g_idle_jobs[job].step != nullptr };
+    stats = g_idle_jobs[job].stats;
+    taskEXIT_CRITICAL();
+
+    return valid;
+}
+
+void run_idle_jobs() {
+    idle_job_t step {};
+    void* arg {};
+    uint32_t budget {};
+    uint8_t job {};
+
+    taskENTER_CRITICAL();
+    for (uint8_t i {}; i < MAX_IDLE_JOBS && !step; ++i) {
+        job = g_next_job;
+        g_next_job = (g_next_job + 1) % MAX_IDLE_JOBS;
+        step = g_idle_jobs[job].step;
+        arg = g_idle_jobs[job].arg;
+        budget = g_idle_jobs[job].budget;
+    }
+    if (step) {
+        g_running_job = static_cast<int8_t>(job);
+    }
+    taskEXIT_CRITICAL();
+
+    if (!step) {
+        return;
+    }
+
+    idle_job_stats& stats { g_idle_jobs[job].stats };
+    const uint32_t start { ARM_DWT_CYCCNT };
+    while (::xTaskIdleShouldYield() == pdFALSE) {
+        const auto runtime { idle_runtime() };
+        const uint32_t step_start { ARM_DWT_CYCCNT };
+        const bool more { step(arg) };
+        const uint32_t now { ARM_DWT_CYCCNT };
+        const uint32_t cycles { now - step_start };
+
+        taskENTER_CRITICAL();
+        ++stats.steps;
+        if (idle_runtime() != runtime) {
+            /* runtime includes other tasks */
+            ++stats.preempted;
+        } else {
+            stats.total_runtime += cycles;
+            if (cycles > stats.max_runtime) {
+                stats.max_runtime = cycles;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if (!more || now - start >= budget) {
+            break;
+        }
+    }
+
+    g_running_job = -1;
+}
+} // namespace freertos
+#endif // configUSE_IDLE_HOOK == 1
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    idle_jobs.h
+ * @brief   Background jobs run in small steps by the idle task
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#pragma once
+
+#include <cstdint>
+
+
+namespace freertos {
+static constexpr uint8_t MAX_IDLE_JOBS { 8 };
+
+/**
+ * @brief Step of an idle job
+ * @param[in] arg: Argument given to add_idle_job()
+ * @return true if the job has more work to do, false if it is done for now
+ * @note Runs in the idle task, so it must never block. A step should take a few microseconds at most, it is preempted by any task of higher
+ *       priority becoming ready, but delays tasks sharing the idle priority until it returns.
+ */
+using idle_job_t = bool (*)(void* arg);
+
+/**
+ * @brief Runtime statistics of an idle job, times in CPU cycles
+ */
+struct idle_job_stats {
+    const char* name;
+    uint32_t steps; /**< Number of steps run */
+    uint64_t total_runtime; /**< Runtime of all steps, without the steps preempted by other tasks */
+    uint32_t max_runtime; /**< Runtime of a step, worst case without the steps preempted by other tasks */
+    uint32_t preempted; /**< Number of steps preempted by other tasks */
+};
+
+/**
+ * @brief Add a job run by the idle task
+ * @param[in] name: Name of the job, the string must not be freed
+ * @param[in] step: Function to run one step of the job
+ * @param[in] arg: Argument passed to step
+ * @param[in] budget: Maximum time in CPU cycles to spend in the job per turn, steps are not interrupted when the budget is exceeded
+ * @return Number of the job or -1 if the job table is full
+ * @note The idle task runs the jobs in round robin order, one job per turn. A turn runs steps until the step returns false, the budget
+ *       is used up or another task becomes ready. Requires configUSE_IDLE_HOOK to be set to 1.
+ */
+int8_t add_idle_job(const char* name, idle_job_t step, void* arg, uint32_t budget);
+
+/**
+ * @brief Remove a job from the idle task
+ * @param[in] job: Number of the job returned by add_idle_job()
+ * @note If the step of the job is running, waits until it returned. Must not be called from the idle task.
+ */
+void remove_idle_job(int8_t job);
+
+/**
+ * @brief Get the runtime statistics of an idle job
+ * @param[in] job: Number of the job
+ * @param[out] stats: Statistics
+ * @return true on success, false if there is no such job
+ */
+bool get_idle_job_stats(int8_t job, idle_job_stats& stats);
+
+/**
+ * @brief Run the next idle job for one turn, called by vApplicationIdleHook()
+ */
+void run_idle_jobs();
+} // namespace freertos
@@ -0,0 +1,191 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    lock_stats.cpp
+ * @brief   Wait and hold times of mutexes per lock and callsite
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "lock_stats.h"
+#include "teensy.h"
+#include "arduino_freertos.h"
+
+#include <cstring>
+
+
+#if configUSE_LOCK_STATS == 1
+namespace freertos {
+namespace {
+static_assert((LOCK_STATS_MAX_LOCKS & (LOCK_STATS_MAX_LOCKS - 1)) == 0, "LOCK_STATS_MAX_LOCKS must be a power of 2");
+static_assert((LOCK_STATS_MAX_CALLSITES & (LOCK_STATS_MAX_CALLSITES - 1)) == 0, "LOCK_STATS_MAX_CALLSITES must be a power of 2");
+static_assert(LOCK_STATS_MAX_CALLSITES <= INT16_MAX, "LOCK_STATS_MAX_CALLSITES too large");
+
+struct entry {
+    lock_stats stats;
+    uint32_t taken_at; /**< Time of the current acquisition, only valid for lock entries */
+    int16_t holder; /**< Callsite entry of the current acquisition or -1, only valid for lock entries */
+    bool held;
+};
+
+/* open addressing with linear probing, entries are only removed by reset_lock_stats(). Protected by critical sections. */
+entry g_locks[LOCK_STATS_MAX_LOCKS];
+entry g_sites[LOCK_STATS_MAX_CALLSITES];
+uint32_t g_dropped;
+
+inline size_t hash(const void* lock, const void* callsite) {
+    const uint32_t key { static_cast<uint32_t>(reinterpret_cast<uintptr_t>(lock) ^ (reinterpret_cast<uintptr_t>(callsite) * 31U)) };
+    return ((key >> 2) * 2'654'435'761U) >> 16;
+}
+
+/* must be called in a critical section */
+template <size_t N>
+entry* find(entry (&table)[N], const void* lock, const void* callsite, bool insert) {
+    size_t pos { hash(lock, callsite) };
+    for (size_t i {}; i < N; ++i, ++pos) {
+        entry& e { table[pos & (N - 1)] };
+        if (e.stats.lock == lock && e.stats.callsite == callsite) {
+            return &e;
+        }
+        if (!e.stats.lock) {
+            if (!insert) {
+                return nullptr;
+            }
+            e.stats.lock = lock;
+            e.stats.callsite = callsite;
+            e.holder = -1;
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+/* must be called in a critical section */
+void add_take(lock_stats& stats, bool contended, bool success, uint32_t wait_us) {
+    if (success) {
+        ++stats.acquisitions;
+    } else {
+        ++stats.failures;
+    }
+    if (contended) {
+        ++stats.contentions;
+        stats.total_wait_us += wait_us;
+        if (wait_us > stats.max_wait_us) {
+            stats.max_wait_us = wait_us;
+        }
+    }
+}
+
+/* must be called in a critical section */
+void add_hold(lock_stats& stats, uint32_t hold_us) {
+    stats.total_hold_us += hold_us;
+    if (hold_us > stats.max_hold_us) {
+        stats.max_hold_us = hold_us;
+    }
+}
+} // namespace
+
+size_t get_lock_stats(lock_stats* stats, size_t max, const void* lock) {
+    entry* const table { lock ? g_sites : g_locks };
+    const size_t size { lock ? LOCK_STATS_MAX_CALLSITES : LOCK_STATS_MAX_LOCKS };
+    size_t num {};
+
+    for (size_t i {}; i < size && max; ++i) {
+        /* copy one entry at a time to keep the critical sections short */
+        taskENTER_CRITICAL();
+        const lock_stats current { table[i].stats };
+        taskEXIT_CRITICAL();
+
+        if (!current.lock || (lock && current.lock != lock)) {
+            continue;
+        }
+
+        /* insertion sort by total wait time, the entry with the least wait time falls off if stats is full */
+        size_t pos { num < max ? num++ : max };
+        while (pos && stats[pos - 1].total_wait_us < current.total_wait_us) {
+            if (pos < max) {
+                stats[pos] = stats[pos - 1];
+            }
+            --pos;
+        }
+        if (pos < max) {
+            stats[pos] = current;
+        }
+    }
+
+    return num;
+}
+
+void reset_lock_stats() {
+    taskENTER_CRITICAL();
+    std::memset(g_locks, 0, sizeof(g_locks));
+    std::memset(g_sites, 0, sizeof(g_sites));
+    g_dropped = 0;
+    taskEXIT_CRITICAL();
+}
+
+uint32_t get_lock_stats_dropped() {
+    return g_dropped;
+}
+} // namespace freertos
+
+extern "C" void vPortLockStatsTaken(void* lock, void* callsite, uint32_t start_time, BaseType_t contended, BaseType_t success) {
+    using namespace freertos;
+
+    const uint32_t now { static_cast<uint32_t>(get_us()) };
+
+    taskENTER_CRITICAL();
+    entry* const p_lock { find(g_locks, lock, nullptr, true) };
+    entry* const p_site { find(g_sites, lock, callsite, true) };
+    if (!p_lock || !p_site) {
+        ++g_dropped;
+    }
+
+    if (p_lock) {
+        add_take(p_lock->stats, contended, success, now - start_time);
+        if (success) {
+            p_lock->taken_at = now;
+            p_lock->holder = p_site ? static_cast<int16_t>(p_site - g_sites) : -1;
+            p_lock->held = true;
+        }
+    }
+    if (p_site) {
+        add_take(p_site->stats, contended, success, now - start_time);
+    }
+    taskEXIT_CRITICAL();
+}
+
+extern "C" void vPortLockStatsGiven(void* lock) {
+    using namespace freertos;
+
+    const uint32_t now { static_cast<uint32_t>(get_us()) };
+
+    taskENTER_CRITICAL();
+    entry* const p_lock { find(g_locks, lock, nullptr, false) };
+    if (p_lock && p_lock->held) {
+        const uint32_t hold { now - p_lock->taken_at };
+        add_hold(p_lock->stats, hold);
+        if (p_lock->holder >= 0) {
+            add_hold(g_sites[p_lock->holder].stats, hold);
+        }
+        p_lock->held = false;
+    }
+    taskEXIT_CRITICAL();
+}
+#endif // configUSE_LOCK_STATS
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    lock_stats.h
+ * @brief   Wait and hold times of mutexes per lock and callsite
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace freertos {
+static constexpr size_t LOCK_STATS_MAX_LOCKS { 32 }; /**< Size of the lock table, must be a power of 2 */
+static constexpr size_t LOCK_STATS_MAX_CALLSITES { 64 }; /**< Size of the callsite table, must be a power of 2 */
+
+/**
+ * @brief Statistics of a lock or of a callsite of a lock
+ */
+struct lock_stats {
+    const void* lock; /**< Handle of the mutex */
+    const void* callsite; /**< Return address of the take call or nullptr for the totals of the lock */
+    uint32_t acquisitions; /**< Number of successful takes */
+    uint32_t contentions; /**< Number of takes finding the mutex held by another task */
+    uint32_t failures; /**< Number of takes returning without the mutex */
+    uint32_t max_wait_us;
+    uint32_t max_hold_us;
+    uint64_t total_wait_us;
+    uint64_t total_hold_us;
+};
+
+/**
+ * @brief Get the statistics of all locks or of all callsites of a lock, ranked by total wait time
+ * @param[out] stats: Array for the statistics
+ * @param[in] max: Number of entries in stats
+ * @param[in] lock: Handle of the mutex to get the callsites of, nullptr for the totals of all locks
+ * @return Number of entries written to stats
+ * @note Only available with configUSE_LOCK_STATS. This covers FreeRTOS mutexes, recursive mutexes and std::mutex, std::recursive_mutex
+ *       as they are built on them. Wait times include the time a take spends in the kernel, hold times are accounted to the callsite
+ *       that took the mutex. The statistics of a deleted mutex stay in the tables until reset_lock_stats() is called.
+ */
+size_t get_lock_stats(lock_stats* stats, size_t max, const void* lock = nullptr);
+
+/**
+ * @brief Clear the statistics of all locks
+ * @note Mutexes held while resetting are not accounted until they are taken again
+ */
+void reset_lock_stats();
+
+/**
+ * @brief Get the number of takes not accounted because a table was full
+ * @return Number of dropped takes since the last reset
+ */
+uint32_t get_lock_stats_dropped();
+} // namespace freertos
@@ -0,0 +1,292 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    memcpy_m7.cpp
+ * @brief   Copy and fill routines for the Cortex-M7 with optional eDMA offload
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "memcpy_m7.h"
+#include "arduino_freertos.h"
+#include "semphr.h"
+
+#include <cstring>
+
+#if defined __IMXRT1062__
+#include "DMAChannel.h"
+
+
+namespace {
+/* the M7 handles unaligned word accesses to normal memory in hardware */
+typedef uint32_t __attribute__((aligned(1), may_alias)) unaligned_u32;
+
+/* copy less than 16 bytes, all loads are done before the first store */
+__attribute__((always_inline)) inline void copy_small(uint8_t* d, const uint8_t* s, const size_t n) {
+    if (n >= 8) {
+        const uint32_t a { *reinterpret_cast<const unaligned_u32*>(s) };
+        const uint32_t b { *reinterpret_cast<const unaligned_u32*>(s + 4) };
+        const uint32_t c { *reinterpret_cast<const unaligned_u32*>(s + n - 8) };
+        const uint32_t e { *reinterpret_cast<const unaligned_u32*>(s + n - 4) };
+        *reinterpret_cast<unaligned_u32*>(d) = a;
+        *reinterpret_cast<unaligned_u32*>(d + 4) = b;
+        *reinterpret_cast<unaligned_u32*>(d + n - 8) = c;
+        *reinterpret_cast<unaligned_u32*>(d + n - 4) = e;
+    } else if (n >= 4) {
+        const uint32_t a { *reinterpret_cast<const unaligned_u32*>(s) };
+        const uint32_t b { *reinterpret_cast<const unaligned_u32*>(s + n - 4) };
+        *reinterpret_cast<unaligned_u32*>(d) = a;
+        *reinterpret_cast<unaligned_u32*>(d + n - 4) = b;
+    } else if (n) {
+        const uint8_t a { s[0] };
+        const uint8_t b { s[n >> 1] };
+        const uint8_t c { s[n - 1] };
+        d[0] = a;
+        d[n >> 1] = b;
+        d[n - 1] = c;
+    }
+}
+} // namespace
+
+extern "C" {
+/* no-tree-loop-distribute-patterns: gcc must not turn the loops into memcpy() calls */
+FASTRUN __attribute__((optimize("no-tree-loop-distribute-patterns"))) void* pvPortMemcpy(void* dst, const void* src, size_t n) {
+    uint8_t* d { static_cast<uint8_t*>(dst) };
+    const uint8_t* s { static_cast<const uint8_t*>(src) };
+
+    if (n < 16) {
+        copy_small(d, s, n);
+        return dst;
+    }
+
+    if (((reinterpret_cast<uintptr_t>(d) ^ reinterpret_cast<uintptr_t>(s)) & 3) == 0) {
+        while (reinterpret_cast<uintptr_t>(d) & 3) {
+            *d++ = *s++;
+            --n;
+        }
+
+        if (n >= 32) {
+            /* 32 byte bursts, r7 is left alone as it may be the frame pointer */
+            __asm volatile("1:                                                     \n\t"
+                           "ldmia %[s]!, {r3, r4, r5, r6, r8, r9, r10, r12}         \n\t"
+                           "stmia %[d]!, {r3, r4, r5, r6, r8, r9, r10, r12}         \n\t"
+                           "sub %[n], %[n], #32                                     \n\t"
+                           "cmp %[n], #32                                           \n\t"
+                           "bhs 1b                                                  \n\t"
+                           : [s] "+r"(s), [d] "+r"(d), [n] "+r"(n)
+                           :
+                           : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+        }
+
+        while (n >= 8) {
+            uint32_t a, b;
+            __asm volatile("ldrd %[a], %[b], [%[s]], #8 \n\t"
+                           "strd %[a], %[b], [%[d]], #8 \n\t"
+                           : [s] "+r"(s), [d] "+r"(d), [a] "=&r"(a), [b] "=&r"(b)
+                           :
+                           : "memory");
+            n -= 8;
+        }
+    } else {
+        /* different alignment: aligned stores, unaligned loads */
+        while (reinterpret_cast<uintptr_t>(d) & 3) {
+            *d++ = *s++;
+            --n;
+        }
+
+        while (n >= 16) {
+            const uint32_t a { *reinterpret_cast<const unaligned_u32*>(s) };
+            const uint32_t b { *reinterpret_cast<const unaligned_u32*>(s + 4) };
+            const uint32_t c { *reinterpret_cast<const unaligned_u32*>(s + 8) };
+            const uint32_t e { *reinterpret_cast<const unaligned_u32*>(s + 12) };
+            reinterpret_cast<uint32_t*>(d)[0] = a;
+            reinterpret_cast<uint32_t*>(d)[1] = b;
+            reinterpret_cast<uint32_t*>(d)[2] = c;
+            reinterpret_cast<uint32_t*>(d)[3] = e;
+            s += 16;
+            d += 16;
+            n -= 16;
+        }
+    }
+
+    copy_small(d, s, n);
+    return dst;
+}
+
+FASTRUN __attribute__((optimize("no-tree-loop-distribute-patterns"))) void* pvPortMemset(void* dst, int c, size_t n) {
+    uint8_t* d { static_cast<uint8_t*>(dst) };
+    const uint32_t v { static_cast<uint8_t>(c) * 0x0101'0101U };
+
+    if (n < 16) {
+        if (n >= 8) {
+            *reinterpret_cast<unaligned_u32*>(d) = v;
+            *reinterpret_cast<unaligned_u32*>(d + 4) = v;
+            *reinterpret_cast<unaligned_u32*>(d + n - 8) = v;
+            *reinterpret_cast<unaligned_u32*>(d + n - 4) = v;
+        } else if (n >= 4) {
+            *reinterpret_cast<unaligned_u32*>(d) = v;
+            *reinterpret_cast<unaligned_u32*>(d + n - 4) = v;
+        } else if (n) {
+            d[0] = static_cast<uint8_t>(v);
+            d[n >> 1] = static_cast<uint8_t>(v);
+            d[n - 1] = static_cast<uint8_t>(v);
+        }
+        return dst;
+    }
+
+    /* unaligned head and tail are written with overlapping word stores */
+    uint8_t* const end { d + n };
+    *reinterpret_cast<unaligned_u32*>(d) = v;
+    uint8_t* const aligned { reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(d) + 4) & ~static_cast<uintptr_t>(3)) };
+    n -= aligned - d;
+    d = aligned;
+
+    if (n >= 32) {
+        __asm volatile("mov r3, %[v]                     \n\t"
+                       "mov r4, %[v]                     \n\t"
+                       "mov r5, %[v]                     \n\t"
+                       "mov r6, %[v]                     \n\t"
+                       "1:                               \n\t"
+                       "stmia %[d]!, {r3, r4, r5, r6}    \n\t"
+                       "stmia %[d]!, {r3, r4, r5, r6}    \n\t"
+                       "sub %[n], %[n], #32              \n\t"
+                       "cmp %[n], #32                    \n\t"
+                       "bhs 1b                           \n\t"
+                       : [d] "+r"(d), [n] "+r"(n)
+                       : [v] "r"(v)
+                       : "r3", "r4", "r5", "r6", "cc", "memory");
+    }
+
+    while (n >= 8) {
+        __asm volatile("strd %[v], %[v], [%[d]], #8" : [d] "+r"(d) : [v] "r"(v) : "memory");
+        n -= 8;
+    }
+
+    *reinterpret_cast<unaligned_u32*>(end - 8) = v;
+    *reinterpret_cast<unaligned_u32*>(end - 4) = v;
+    return dst;
+}
+} // extern C
+
+namespace freertos {
+namespace {
+static constexpr UBaseType_t NOTIFICATION_INDEX { configDMA_COPY_NOTIFICATION_INDEX };
+static_assert(NOTIFICATION_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 && NOTIFICATION_INDEX != configSTOP_STATE_NOTIFICATION_INDEX
+        && NOTIFICATION_INDEX != configTIMER_NOTIFICATION_INDEX,
+    "configDMA_COPY_NOTIFICATION_INDEX must be a reserved index of its own");
+
+DMAChannel* g_dma;
+SemaphoreHandle_t g_dma_mutex;
+TaskHandle_t g_dma_waiter;
+
+void dma_isr() {
+    g_dma->clearInterrupt();
+
+    BaseType_t higher_woken { pdFALSE };
+    ::vTaskNotifyGiveIndexedFromISR(g_dma_waiter, NOTIFICATION_INDEX, &higher_woken);
+    portYIELD_FROM_ISR(higher_woken);
+    portDATA_SYNC_BARRIER(); // mitigate arm errata #838869
+}
+
+/* transfer size code of the eDMA for the alignment of an address */
+uint8_t dma_size(const uintptr_t addr) {
+    return (addr & 31) == 0 ? 5 : ((addr & 3) == 0 ? 2 : 0);
+}
+} // namespace
+
+FLASHMEM bool setup_dma_copy() {
+    if (g_dma) {
+        return true;
+    }
+
+    g_dma_mutex = ::xSemaphoreCreateMutex();
+    if (!g_dma_mutex) {
+        return false;
+    }
+    g_dma = new DMAChannel;
+    if (!g_dma) {
+        ::vSemaphoreDelete(g_dma_mutex);
+        g_dma_mutex = nullptr;
+        return false;
+    }
+    g_dma->attachInterrupt(dma_isr);
+
+    return true;
+}
+
+void* copy(void* dst, const void* src, size_t n) {
+    if (n < DMA_COPY_THRESHOLD || !g_dma || xPortIsInsideInterrupt() == pdTRUE || ::xTaskGetSchedulerState() != taskSCHEDULER_RUNNING
+        || ::xSemaphoreTake(g_dma_mutex, 0) != pdTRUE) {
+        return ::pvPortMemcpy(dst, src, n);
+    }
+
+    /* only complete cache lines of dst are written by the eDMA, otherwise invalidating them could drop data next to dst */
+    uint8_t* const d { static_cast<uint8_t*>(dst) };
+    const uint8_t* const s { static_cast<const uint8_t*>(src) };
+    const size_t head { (portCACHE_LINE_SIZE - (reinterpret_cast<uintptr_t>(d) & (portCACHE_LINE_SIZE - 1))) & (portCACHE_LINE_SIZE - 1) };
+    const size_t body { (n - head) & ~static_cast<size_t>(portCACHE_LINE_SIZE - 1) };
+    const size_t tail { n - head - body };
+
+    ::arm_dcache_flush(const_cast<uint8_t*>(s + head), body);
+    ::arm_dcache_delete(d + head, body);
+
+    const uint8_t ssize { dma_size(reinterpret_cast<uintptr_t>(s + head)) };
+    g_dma->TCD->SADDR = s + head;
+    g_dma->TCD->SOFF = 1 << ssize;
+    g_dma->TCD->ATTR = DMA_TCD_ATTR_SSIZE(ssize) | DMA_TCD_ATTR_DSIZE(5);
+    g_dma->TCD->NBYTES_MLNO = body;
+    g_dma->TCD->SLAST = 0;
+    g_dma->TCD->DADDR = d + head;
+    g_dma->TCD->DOFF = 32;
+    g_dma->TCD->CITER_ELINKNO = 1;
+    g_dma->TCD->DLASTSGA = 0;
+    g_dma->TCD->BITER_ELINKNO = 1;
+    g_dma->TCD->CSR = DMA_TCD_CSR_INTMAJOR | DMA_TCD_CSR_DREQ;
+
+    g_dma_waiter = ::xTaskGetCurrentTaskHandle();
+    g_dma->enable();
+    g_dma->triggerManual();
+
+    /* the CPU copies the partial cache lines meanwhile */
+    ::pvPortMemcpy(d, s, head);
+    ::pvPortMemcpy(d + head + body, s + head + body, tail);
+
+    ::ulTaskNotifyTakeIndexed(NOTIFICATION_INDEX, pdTRUE, portMAX_DELAY);
+    g_dma->disable();
+
+    /* drop lines the CPU may have fetched speculatively during the transfer */
+    ::arm_dcache_delete(d + head, body);
+    ::xSemaphoreGive(g_dma_mutex);
+
+    return dst;
+}
+} // namespace freertos
+
+#else // !__IMXRT1062__
+
+namespace freertos {
+bool setup_dma_copy() {
+    return false;
+}
+
+void* copy(void* dst, const void* src, size_t n) {
+    return std::memcpy(dst, src, n);
+}
+} // namespace freertos
+#endif // __IMXRT1062__
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    memcpy_m7.h
+ * @brief   Copy and fill routines for the Cortex-M7 with optional eDMA offload
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+extern "C" {
+/**
+ * @brief memcpy() for the Cortex-M7, used by the kernel as portMEMCPY() on Teensy 4
+ * @note Uses unaligned word accesses, so it must not be used on device memory
+ */
+void* pvPortMemcpy(void* dst, const void* src, size_t n);
+
+/**
+ * @brief memset() for the Cortex-M7, used by the kernel as portMEMSET() on Teensy 4
+ */
+void* pvPortMemset(void* dst, int c, size_t n);
+}
+
+namespace freertos {
+static constexpr size_t DMA_COPY_THRESHOLD { 4'096 }; /**< Minimum size in byte to copy with the eDMA */
+
+/**
+ * @brief Allocate the eDMA channel for copy()
+ * @return true on success
+ * @note Only available on Teensy 4, returns false otherwise
+ */
+bool setup_dma_copy();
+
+/**
+ * @brief Copy memory, large blocks are copied by the eDMA while the calling task is blocked
+ * @param[in] dst: Destination buffer
+ * @param[in] src: Source buffer
+ * @param[in] n: Number of bytes to copy
+ * @return dst
+ * @note Uses the CPU if n < DMA_COPY_THRESHOLD, if setup_dma_copy() was not called, if the channel is in use by another task
+ *       or if called from an ISR or with the scheduler suspended. The data cache is maintained, the CPU copies the parts of dst
+ *       not filling complete cache lines.
+ */
+void* copy(void* dst, const void* src, size_t n);
+} // namespace freertos
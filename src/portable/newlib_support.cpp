@@ -34,6 +34,9 @@
 
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "idle_jobs.h"
+#include "small_alloc.h"
+#include "teensy.h"
 
 #if defined ARDUINO_TEENSY40 || defined ARDUINO_TEENSY41 || defined ARDUINO_TEENSY_MICROMOD
 #include "imxrt.h"
@@ -57,6 +60,7 @@ struct __lock {
 
 static std::atomic<uint32_t> g_malloc_nesting {};
 static uint32_t g_malloc_irq_mask { ~0U };
+static std::atomic<void*> g_deferred_free {}; /**< Blocks freed by free_from_isr(), linked through their first word */
 static SemaphoreHandle_t g_cxa_guard_recursive_mutex;
 
 __lock __lock___sfp_recursive_mutex { nullptr };
@@ -68,12 +72,31 @@ __lock __lock___dd_hash_mutex { nullptr };
 __lock __lock___arc4random_mutex { nullptr };
 
 
-void __malloc_lock(struct _reent*) {
+static inline void release_block(struct _reent* r, void* ptr) {
+#if configUSE_SMALL_OBJECT_ALLOCATOR == 1
+    (void) r;
+    freertos::small_free(ptr);
+#else
+    _free_r(r, ptr);
+#endif
+}
+
+void __malloc_lock(struct _reent* r) {
     const auto old_nesting { g_malloc_nesting.fetch_add(1) };
 
     if (__builtin_expect(old_nesting, 0) == 0) {
         configASSERT(g_malloc_irq_mask == ~0U);
         g_malloc_irq_mask = ulPortRaiseBASEPRI();
+
+        /* free the blocks deferred by ISRs while the lock is held anyway, the nested lock calls are cheap */
+        if (__builtin_expect(g_deferred_free.load(std::memory_order_relaxed) != nullptr, 0)) {
+            void* p_block { g_deferred_free.exchange(nullptr, std::memory_order_acquire) };
+            while (p_block) {
+                void* const p_next { *static_cast<void**>(p_block) };
+                release_block(r, p_block);
+                p_block = p_next;
+            }
+        }
     }
 };
 
@@ -175,6 +198,16 @@ FLASHMEM void init_newlib_locks() {
     __lock___tz_mutex.handle_ = xSemaphoreCreateMutexStatic(&s_tz_mutex_buffer);
     __lock___dd_hash_mutex.handle_ = xSemaphoreCreateMutexStatic(&s_dd_hash_mutex_buffer);
     __lock___arc4random_mutex.handle_ = xSemaphoreCreateMutexStatic(&s_arc4random_mutex_buffer);
+
+#if configUSE_IDLE_HOOK == 1
+    freertos::add_idle_job(
+        PSTR("free"),
+        [](void*) {
+            freertos::drain_deferred_free();
+            return false;
+        },
+        nullptr, 0);
+#endif
 }
 
 FLASHMEM void __retarget_lock_init(_LOCK_T* p_lock_ptr) {
@@ -246,3 +279,33 @@ int _getpid() {
     return reinterpret_cast<int>(xTaskGetCurrentTaskHandle());
 }
 } // extern C
+
+namespace freertos {
+void free_from_isr(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    /* lock-free push, the list is only ever taken as a whole, so there is no ABA problem */
+    void* head { g_deferred_free.load(std::memory_order_relaxed) };
+    do {
+        *static_cast<void**>(ptr) = head;
+    } while (!g_deferred_free.compare_exchange_weak(head, ptr, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void free_bulk(void* const* ptrs, size_t num) {
+    __malloc_lock(_impure_ptr);
+    for (size_t i {}; i < num; ++i) {
+        release_block(_impure_ptr, ptrs[i]);
+    }
+    __malloc_unlock(_impure_ptr);
+}
+
+void drain_deferred_free() {
+    if (g_deferred_free.load(std::memory_order_relaxed)) {
+        /* the lock frees the deferred blocks */
+        __malloc_lock(_impure_ptr);
+        __malloc_unlock(_impure_ptr);
+    }
+}
+} // namespace freertos
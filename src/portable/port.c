@@ -162,6 +162,13 @@ void prvTaskExitError( void ) __attribute__ (( section( ".flashmem" ) ));
  * variable. */
 static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 
+/*
+ * Second level of the ready priority bit map, see portRECORD_READY_PRIORITY().
+ */
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) && ( configMAX_PRIORITIES > 32 ) )
+    uint32_t ulPortReadyPriorities[ portREADY_PRIORITY_GROUPS ];
+#endif
+
 /*
  * The number of SysTick increments that make up one tick period.
  */
@@ -86,6 +86,11 @@ typedef unsigned long    UBaseType_t;
 #define portTICK_PERIOD_MS    ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portBYTE_ALIGNMENT    8
 #define portDONT_DISCARD      __attribute__( ( used ) )
+
+/* Data cache line size of the Cortex-M7.  The Cortex-M4 has no data cache, the
+ * same value is used there to get the same structure layouts. */
+#define portCACHE_LINE_SIZE       32
+#define portCACHE_LINE_ALIGNED    __attribute__( ( aligned( portCACHE_LINE_SIZE ) ) )
 /*-----------------------------------------------------------*/
 
 /* Scheduler utilities. */
@@ -162,17 +167,53 @@ extern void vPortExitCritical( void );
     }
 
 /* Check the configuration. */
-    #if ( configMAX_PRIORITIES > 32 )
-        #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+    #if ( configMAX_PRIORITIES > 1024 )
+        #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.
     #endif
 
+    #if ( configMAX_PRIORITIES <= 32 )
+
 /* Store/clear the ready priorities in a bit map. */
-    #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )    ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
-    #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+        #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )    ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+        #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+/*-----------------------------------------------------------*/
+
+        #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )    uxTopPriority = ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+
+    #else /* configMAX_PRIORITIES <= 32 */
+
+/* Two level bit map for more than 32 priorities: bit n of uxReadyPriorities is
+ * set if any priority of group n (priorities 32 * n to 32 * n + 31) has ready
+ * tasks, ulPortReadyPriorities[ n ] holds the ready priorities of group n. */
+        #define portREADY_PRIORITY_GROUPS    ( ( configMAX_PRIORITIES + 31 ) / 32 )
+
+        extern uint32_t ulPortReadyPriorities[ portREADY_PRIORITY_GROUPS ];
+
+        #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )                          \
+    do {                                                                                            \
+        ulPortReadyPriorities[ ( uint32_t ) ( uxPriority ) >> 5UL ] |= ( 1UL << ( ( uxPriority ) & 31UL ) ); \
+        ( uxReadyPriorities ) |= ( 1UL << ( ( uint32_t ) ( uxPriority ) >> 5UL ) );                \
+    } while( 0 )
+
+        #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )                            \
+    do {                                                                                             \
+        ulPortReadyPriorities[ ( uint32_t ) ( uxPriority ) >> 5UL ] &= ~( 1UL << ( ( uxPriority ) & 31UL ) ); \
+        if( ulPortReadyPriorities[ ( uint32_t ) ( uxPriority ) >> 5UL ] == 0UL )                     \
+        {                                                                                            \
+            ( uxReadyPriorities ) &= ~( 1UL << ( ( uint32_t ) ( uxPriority ) >> 5UL ) );             \
+        }                                                                                            \
+    } while( 0 )
 
 /*-----------------------------------------------------------*/
 
-    #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )    uxTopPriority = ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+        #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )                          \
+    do {                                                                                              \
+        const uint32_t ulGroup = 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ) ); \
+        uxTopPriority = ( ulGroup << 5UL ) + ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ulPortReadyPriorities[ ulGroup ] ) ); \
+    } while( 0 )
+
+    #endif /* configMAX_PRIORITIES <= 32 */
 
 #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
@@ -276,6 +317,12 @@ portFORCE_INLINE static void* pvPortMalloc( size_t xSize ) PRIVILEGED_FUNCTION {
     return malloc( xSize );
 }
 
+void* memalign( size_t, size_t ) __attribute__( ( __malloc__, __warn_unused_result__, __alloc_size__( 2 ) ) );
+portFORCE_INLINE static void* pvPortMallocAligned( size_t xAlignment, size_t xSize ) PRIVILEGED_FUNCTION __attribute__( ( __malloc__, __warn_unused_result__, __alloc_size__( 2 ) ) );
+portFORCE_INLINE static void* pvPortMallocAligned( size_t xAlignment, size_t xSize ) PRIVILEGED_FUNCTION {
+    return memalign( xAlignment, xSize );
+}
+
 void* calloc( size_t, size_t ) __attribute__( ( __malloc__, __warn_unused_result__, __alloc_size__( 1, 2 ) ) );
 portFORCE_INLINE static void* pvPortCalloc( size_t xNum, size_t xSize ) PRIVILEGED_FUNCTION __attribute__( ( __malloc__, __warn_unused_result__, __alloc_size__( 1, 2 ) ) );
 portFORCE_INLINE static void* pvPortCalloc( size_t xNum, size_t xSize ) PRIVILEGED_FUNCTION {
@@ -287,6 +334,48 @@ portFORCE_INLINE static void vPortFree( void* pv ) PRIVILEGED_FUNCTION {
     free( pv );
 }
 
+/*
+ * Per-task caches of the small object allocator (small_alloc.cpp) are given
+ * back when a task is deleted.
+ */
+#ifndef configUSE_SMALL_OBJECT_ALLOCATOR
+    #define configUSE_SMALL_OBJECT_ALLOCATOR    0
+#endif
+
+#if configUSE_SMALL_OBJECT_ALLOCATOR == 1
+    void vPortCleanUpTCB( void * pxTCB );
+
+    #define portCLEAN_UP_TCB( pxTCB )    vPortCleanUpTCB( pxTCB )
+#endif
+
+/*
+ * Mutex acquisitions and releases are reported to the lock statistics
+ * (lock_stats.cpp) with the return address of the calling API function.
+ */
+#if defined( configUSE_LOCK_STATS ) && ( configUSE_LOCK_STATS == 1 )
+    #if configGENERATE_RUN_TIME_STATS != 1
+        #error configUSE_LOCK_STATS requires configGENERATE_RUN_TIME_STATS
+    #endif
+
+    void vPortLockStatsTaken( void * pvLock, void * pvCallsite, uint32_t ulStartTime, BaseType_t xContended, BaseType_t xSuccess );
+    void vPortLockStatsGiven( void * pvLock );
+
+    #define portLOCK_STATS_CALLSITE()    __builtin_return_address( 0 )
+    #define portLOCK_STATS_TIME()        ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+#endif
+
+/*
+ * Copy and fill routines used by the kernel for queue items, stream buffer data
+ * and stack painting.  The Cortex-M7 versions are in memcpy_m7.cpp.
+ */
+#if defined __IMXRT1062__
+    void * pvPortMemcpy( void * pvDst, const void * pvSrc, size_t xSize );
+    void * pvPortMemset( void * pvDst, int iValue, size_t xSize );
+
+    #define portMEMCPY( pvDst, pvSrc, xSize )    pvPortMemcpy( ( pvDst ), ( pvSrc ), ( xSize ) )
+    #define portMEMSET( pvDst, iValue, xSize )   pvPortMemset( ( pvDst ), ( iValue ), ( xSize ) )
+#endif
+
 portFORCE_INLINE static uint32_t __get_PRIMASK( void ) {
     uint32_t result;
 
@@ -0,0 +1,277 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    rcu.cpp
+ * @brief   Quiescent-state-based deferred reclamation (RCU) for lock-free readers
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#include "rcu.h"
+#include "idle_jobs.h"
+#include "small_alloc.h"
+#include "arduino_freertos.h"
+
+#include <new>
+#include <algorithm>
+
+
+#if configUSE_RCU == 1
+static_assert(configNUM_THREAD_LOCAL_STORAGE_POINTERS > configRCU_TLS_INDEX, "configNUM_THREAD_LOCAL_STORAGE_POINTERS too small");
+static_assert(configRCU_TLS_INDEX != 0 && configRCU_TLS_INDEX != freertos::SMALL_ALLOC_TLS_INDEX, "configRCU_TLS_INDEX already in use");
+static_assert(configUSE_TRACE_FACILITY == 1, "configUSE_TRACE_FACILITY must be set to 1 for RCU");
+
+namespace freertos {
+namespace rcu {
+namespace {
+struct pending_task {
+    TaskHandle_t task;
+    uintptr_t count; /**< Quiescent state counter at the start of the grace period */
+};
+
+struct retired {
+    void* ptr;
+    retire_t fn;
+    uint32_t grace_period; /**< Grace period to wait for */
+};
+
+/* grace period state and retired objects, protected by suspending the scheduler */
+TaskHandle_t g_initial_tasks[RCU_MAX_TASKS];
+pending_task g_initial_pending[RCU_MAX_TASKS];
+TaskHandle_t* g_tasks { g_initial_tasks };
+pending_task* g_pending { g_initial_pending };
+UBaseType_t g_capacity { RCU_MAX_TASKS };
+UBaseType_t g_num_pending;
+bool g_active;
+uint32_t g_completed;
+uint32_t g_requested;
+retired g_retired[RCU_MAX_RETIRED];
+uint8_t g_retired_head;
+uint8_t g_num_retired;
+TickType_t g_last_poll;
+bool g_job_added;
+
+/* odd while the task is blocked or suspended, changes on every quiescent state */
+inline uintptr_t counter(TaskHandle_t task) {
+    return reinterpret_cast<uintptr_t>(::pvTaskGetThreadLocalStoragePointer(task, configRCU_TLS_INDEX));
+}
+
+inline bool reached(uint32_t grace_period) {
+    return static_cast<int32_t>(g_completed - grace_period) >= 0;
+}
+
+/* must be called with the scheduler suspended, grows the snapshot arrays if more than RCU_MAX_TASKS tasks exist */
+UBaseType_t get_task_handles() {
+    const UBaseType_t num_tasks { ::uxTaskGetNumberOfTasks() };
+    if (num_tasks > g_capacity) {
+        const UBaseType_t capacity { num_tasks + RCU_MAX_TASKS / 4 };
+        auto p_tasks { new (std::nothrow) TaskHandle_t[capacity] };
+        auto p_pending { new (std::nothrow) pending_task[capacity] };
+        if (!p_tasks || !p_pending) {
+            /* retried on the next poll */
+            delete[] p_tasks;
+            delete[] p_pending;
+            return 0;
+        }
+
+        std::copy_n(g_pending, g_num_pending, p_pending);
+        if (g_tasks != g_initial_tasks) {
+            delete[] g_tasks;
+            delete[] g_pending;
+        }
+        g_tasks = p_tasks;
+        g_pending = p_pending;
+        g_capacity = capacity;
+    }
+
+    return ::uxTaskGetTaskHandles(g_tasks, g_capacity);
+}
+
+/* must be called with the scheduler suspended */
+bool start_grace_period() {
+    const UBaseType_t num_tasks { get_task_handles() };
+    if (!num_tasks) {
+        return false;
+    }
+
+    /* the caller is not in a read section, tasks parked in a blocked or suspended state neither */
+    const TaskHandle_t self { ::xTaskGetCurrentTaskHandle() };
+    g_num_pending = 0;
+    for (UBaseType_t i {}; i < num_tasks; ++i) {
+        const uintptr_t count { counter(g_tasks[i]) };
+        if (g_tasks[i] != self && !(count & 1U)) {
+            g_pending[g_num_pending++] = { g_tasks[i], count };
+        }
+    }
+    g_active = true;
+
+    return true;
+}
+
+/* must be called with the scheduler suspended */
+bool check_grace_period() {
+    const UBaseType_t num_tasks { get_task_handles() };
+    if (!num_tasks) {
+        return false;
+    }
+
+    const TaskHandle_t self { ::xTaskGetCurrentTaskHandle() };
+    UBaseType_t i {};
+    while (i < g_num_pending) {
+        /* a task no longer listed was deleted, only handles listed right now may be accessed */
+        bool done { true };
+        if (g_pending[i].task != self) {
+            for (UBaseType_t j {}; j < num_tasks; ++j) {
+                if (g_tasks[j] == g_pending[i].task) {
+                    done = counter(g_tasks[j]) != g_pending[i].count;
+                    break;
+                }
+            }
+        }
+
+        if (done) {
+            g_pending[i] = g_pending[--g_num_pending];
+        } else {
+            ++i;
+        }
+    }
+
+    return g_num_pending == 0;
+}
+
+/* must be called with the scheduler suspended */
+void advance() {
+    while (g_active || g_requested != g_completed) {
+        if (!g_active && !start_grace_period()) {
+            return;
+        }
+        if (!check_grace_period()) {
+            return;
+        }
+        g_active = false;
+        ++g_completed;
+    }
+}
+
+/* must be called with the scheduler suspended, a grace period already running may have started after a reader took its pointer */
+uint32_t request_grace_period() {
+    const uint32_t grace_period { g_completed + (g_active ? 2 : 1) };
+    if (static_cast<int32_t>(grace_period - g_requested) > 0) {
+        g_requested = grace_period;
+    }
+
+    return grace_period;
+}
+
+#if configUSE_IDLE_HOOK == 1
+bool process_retired(void*) {
+    retired entry {};
+
+    ::vTaskSuspendAll();
+    if (g_num_retired) {
+        const TickType_t now { ::xTaskGetTickCount() };
+        if (now != g_last_poll) {
+            g_last_poll = now;
+            advance();
+        }
+        if (reached(g_retired[g_retired_head].grace_period)) {
+            entry = g_retired[g_retired_head];
+            g_retired_head = (g_retired_head + 1) % RCU_MAX_RETIRED;
+            --g_num_retired;
+        }
+    }
+    ::xTaskResumeAll();
+
+    if (!entry.fn) {
+        return false;
+    }
+    entry.fn(entry.ptr);
+
+    return true;
+}
+#endif // configUSE_IDLE_HOOK
+} // namespace
+
+void quiescent_state() {
+    const uintptr_t count { counter(nullptr) };
+    ::vTaskSetThreadLocalStoragePointer(nullptr, configRCU_TLS_INDEX, reinterpret_cast<void*>(count + 2));
+}
+
+void synchronize() {
+    if (::xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return;
+    }
+    configASSERT(!xPortIsInsideInterrupt());
+    configASSERT(::xTaskGetCurrentTaskHandle() != ::xTaskGetIdleTaskHandle());
+
+    ::vTaskSuspendAll();
+    const uint32_t grace_period { request_grace_period() };
+    advance();
+    bool done { reached(grace_period) };
+    ::xTaskResumeAll();
+
+    while (!done) {
+        ::vTaskDelay(1);
+
+        ::vTaskSuspendAll();
+        advance();
+        done = reached(grace_period);
+        ::xTaskResumeAll();
+    }
+}
+
+void retire(void* ptr, retire_t fn) {
+    configASSERT(fn);
+    if (::xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        fn(ptr);
+        return;
+    }
+    configASSERT(!xPortIsInsideInterrupt());
+
+#if configUSE_IDLE_HOOK != 1
+    /* no idle job to run the callbacks */
+    synchronize();
+    fn(ptr);
+#else
+
+    ::vTaskSuspendAll();
+    const bool add_job { !g_job_added };
+    g_job_added = true;
+    const bool queued { g_num_retired < RCU_MAX_RETIRED };
+    if (queued) {
+        g_retired[(g_retired_head + g_num_retired) % RCU_MAX_RETIRED] = { ptr, fn, request_grace_period() };
+        ++g_num_retired;
+    }
+    ::xTaskResumeAll();
+
+    if (add_job) {
+        const int8_t job { add_idle_job(PSTR("rcu"), process_retired, nullptr, RCU_IDLE_JOB_BUDGET) };
+        configASSERT(job >= 0);
+        (void) job;
+    }
+    if (!queued) {
+        synchronize();
+        fn(ptr);
+    }
+#endif // configUSE_IDLE_HOOK
+}
+} // namespace rcu
+} // namespace freertos
+#endif // configUSE_RCU == 1
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    rcu.h
+ * @brief   Quiescent-state-based deferred reclamation (RCU) for lock-free readers
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#pragma once
+
+#include <cstdint>
+
+
+namespace freertos {
+namespace rcu {
+static constexpr uint8_t RCU_MAX_TASKS { 32 }; /**< Number of tasks tracked without allocation, more tasks grow the snapshot from the heap */
+static constexpr uint8_t RCU_MAX_RETIRED { 32 }; /**< Number of objects waiting in retire() for the end of a grace period */
+static constexpr uint32_t RCU_IDLE_JOB_BUDGET { 20'000 }; /**< Budget of the idle job running the callbacks in CPU cycles */
+
+/**
+ * @brief Callback to reclaim a retired object
+ * @param[in] ptr: Pointer given to retire()
+ * @note Runs in the idle task, so it must never block
+ */
+using retire_t = void (*)(void* ptr);
+
+/**
+ * @brief Read a pointer published with assign()
+ * @param[in] ptr: Shared pointer
+ * @return Current value of ptr
+ * @note The object may be used until the reading task blocks, suspends itself or calls quiescent_state(). Being preempted does not end
+ *       the read section, so it needs no locks and no interrupt masking.
+ */
+template <typename T>
+inline T* dereference(T* const& ptr) {
+    return __atomic_load_n(&ptr, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Publish a new object to readers
+ * @param[out] ptr: Shared pointer
+ * @param[in] value: Fully initialized object
+ * @note The old object must be passed to synchronize() or retire() before it is reclaimed
+ */
+template <typename T>
+inline void assign(T*& ptr, T* value) {
+    __atomic_store_n(&ptr, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Report a quiescent state of the calling task
+ * @note Only needed for tasks that run for long periods without blocking, it is called by the idle task on every turn
+ */
+void quiescent_state();
+
+/**
+ * @brief Wait until all read sections active at the time of the call have ended
+ * @note A grace period ends after every other task blocked, suspended itself, called quiescent_state() or was deleted. Polls once per
+ *       tick, must not be called from an ISR or the idle task. A task suspended by another task while being preempted holds the grace
+ *       period until it is resumed and blocks.
+ */
+void synchronize();
+
+/**
+ * @brief Reclaim an object after a grace period without blocking the caller
+ * @param[in] ptr: Object no longer reachable for new readers
+ * @param[in] fn: Function called with ptr from the idle task after the grace period has ended
+ * @note Must not be called from an ISR. If RCU_MAX_RETIRED objects are pending already, it waits with synchronize() and calls fn directly.
+ */
+void retire(void* ptr, retire_t fn);
+
+/**
+ * @brief Delete an object after a grace period without blocking the caller
+ * @param[in] ptr: Object allocated with new and no longer reachable for new readers
+ */
+template <typename T>
+inline void retire(T* ptr) {
+    retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+}
+} // namespace rcu
+} // namespace freertos
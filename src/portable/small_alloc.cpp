@@ -0,0 +1,412 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    small_alloc.cpp
+ * @brief   Small object allocator with per-task caches
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#include "small_alloc.h"
+#include "arduino_freertos.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <bits/functexcept.h>
+
+
+#if configUSE_SMALL_OBJECT_ALLOCATOR == 1
+static_assert(configNUM_THREAD_LOCAL_STORAGE_POINTERS > freertos::SMALL_ALLOC_TLS_INDEX, "configNUM_THREAD_LOCAL_STORAGE_POINTERS too small");
+
+namespace freertos {
+namespace {
+static constexpr size_t NUM_PAGES { SMALL_ALLOC_ARENA_SIZE / SMALL_ALLOC_PAGE_SIZE };
+
+struct free_block {
+    free_block* next;
+    free_block* next_chain; /**< Next full magazine in the depot, only valid for the first block of a magazine */
+};
+
+struct magazine {
+    free_block* head;
+    uint16_t count;
+};
+
+struct task_cache {
+    magazine magazines[SMALL_ALLOC_CLASSES];
+};
+
+struct depot {
+    free_block* full; /**< Stack of magazines with SMALL_ALLOC_MAGAZINE_SIZE blocks each */
+    free_block* loose; /**< Blocks freed one by one */
+    uint16_t loose_count;
+    uint8_t* carve; /**< Next block never used in the last page of the size class or nullptr */
+};
+
+struct class_stats {
+    std::atomic<uint32_t> allocs;
+    std::atomic<uint32_t> frees;
+    std::atomic<uint32_t> refills;
+    std::atomic<uint32_t> flushes;
+    std::atomic<uint32_t> fallbacks;
+    uint16_t pages;
+};
+
+alignas(SMALL_ALLOC_GRANULE) uint8_t g_arena[SMALL_ALLOC_ARENA_SIZE];
+uint8_t g_page_class[NUM_PAGES];
+uint16_t g_next_page;
+depot g_depots[SMALL_ALLOC_CLASSES];
+class_stats g_stats[SMALL_ALLOC_CLASSES];
+
+constexpr uint8_t CACHE_CLASS { (sizeof(task_cache) - 1) / SMALL_ALLOC_GRANULE };
+static_assert(sizeof(task_cache) <= SMALL_ALLOC_MAX_SIZE, "task_cache must fit in a small block");
+
+inline size_t block_size(uint8_t cls) {
+    return (cls + 1U) * SMALL_ALLOC_GRANULE;
+}
+
+inline bool in_arena(const void* ptr) {
+    return static_cast<const uint8_t*>(ptr) >= g_arena && static_cast<const uint8_t*>(ptr) < g_arena + SMALL_ALLOC_ARENA_SIZE;
+}
+
+inline uint8_t class_of(const void* ptr) {
+    const size_t offset { static_cast<size_t>(static_cast<const uint8_t*>(ptr) - g_arena) };
+    const uint8_t cls { g_page_class[offset / SMALL_ALLOC_PAGE_SIZE] };
+    configASSERT(offset / SMALL_ALLOC_PAGE_SIZE < g_next_page && (offset % SMALL_ALLOC_PAGE_SIZE) % block_size(cls) == 0);
+    return cls;
+}
+
+/* reserve up to n unused blocks of the current page of a size class, must be called in a critical section */
+uint16_t carve(uint8_t cls, uint8_t*& start, uint16_t n) {
+    depot& d { g_depots[cls] };
+    if (!d.carve) {
+        if (g_next_page == NUM_PAGES) {
+            return 0;
+        }
+        g_page_class[g_next_page] = cls;
+        ++g_stats[cls].pages;
+        d.carve = g_arena + g_next_page * SMALL_ALLOC_PAGE_SIZE;
+        ++g_next_page;
+    }
+
+    const size_t size { block_size(cls) };
+    const uint8_t* const page_end { g_arena + (static_cast<size_t>(d.carve - g_arena) / SMALL_ALLOC_PAGE_SIZE + 1) * SMALL_ALLOC_PAGE_SIZE };
+    const size_t available { static_cast<size_t>(page_end - d.carve) / size };
+    const uint16_t num { static_cast<uint16_t>(available < n ? available : n) };
+
+    start = d.carve;
+    d.carve += num * size;
+    if (static_cast<size_t>(page_end - d.carve) < size) {
+        d.carve = nullptr;
+    }
+    return num;
+}
+
+free_block* link(uint8_t* start, uint16_t num, size_t size) {
+    for (uint16_t i {}; i < num; ++i) {
+        reinterpret_cast<free_block*>(start + i * size)->next = i + 1U < num ? reinterpret_cast<free_block*>(start + (i + 1U) * size) : nullptr;
+    }
+    return num ? reinterpret_cast<free_block*>(start) : nullptr;
+}
+
+/* get a chain of free blocks for a task cache */
+free_block* refill(uint8_t cls, uint16_t& count) {
+    depot& d { g_depots[cls] };
+    free_block* chain {};
+    uint8_t* start {};
+    uint16_t carved {};
+
+    const UBaseType_t status { taskENTER_CRITICAL_FROM_ISR() };
+    if (d.full) {
+        chain = d.full;
+        d.full = chain->next_chain;
+        count = SMALL_ALLOC_MAGAZINE_SIZE;
+    } else if (d.loose) {
+        chain = d.loose;
+        count = d.loose_count;
+        d.loose = nullptr;
+        d.loose_count = 0;
+    } else {
+        carved = carve(cls, start, SMALL_ALLOC_MAGAZINE_SIZE);
+        count = carved;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+
+    if (count) {
+        ++g_stats[cls].refills;
+    }
+    /* the carved blocks belong to this task now, so they are linked outside the critical section */
+    return chain ? chain : link(start, carved, block_size(cls));
+}
+
+/* allocate a single block without a task cache */
+void* depot_pop(uint8_t cls) {
+    depot& d { g_depots[cls] };
+    void* ptr {};
+
+    const UBaseType_t status { taskENTER_CRITICAL_FROM_ISR() };
+    if (!d.loose && d.full) {
+        d.loose = d.full;
+        d.full = d.full->next_chain;
+        d.loose_count = SMALL_ALLOC_MAGAZINE_SIZE;
+    }
+    if (d.loose) {
+        ptr = d.loose;
+        d.loose = d.loose->next;
+        --d.loose_count;
+    } else {
+        uint8_t* start;
+        if (carve(cls, start, 1)) {
+            ptr = start;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+
+    return ptr;
+}
+
+/* free a single block without a task cache */
+void depot_push(uint8_t cls, free_block* block) {
+    depot& d { g_depots[cls] };
+
+    const UBaseType_t status { taskENTER_CRITICAL_FROM_ISR() };
+    block->next = d.loose;
+    d.loose = block;
+    if (++d.loose_count == SMALL_ALLOC_MAGAZINE_SIZE) {
+        d.loose->next_chain = d.full;
+        d.full = d.loose;
+        d.loose = nullptr;
+        d.loose_count = 0;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+}
+
+/* give a magazine of a task cache back to the depot */
+void flush(uint8_t cls, magazine& mag) {
+    free_block* const chain { mag.head };
+    free_block* tail { chain };
+    for (uint16_t i { 1 }; i < SMALL_ALLOC_MAGAZINE_SIZE; ++i) {
+        tail = tail->next;
+    }
+    mag.head = tail->next;
+    mag.count -= SMALL_ALLOC_MAGAZINE_SIZE;
+    tail->next = nullptr;
+
+    depot& d { g_depots[cls] };
+    const UBaseType_t status { taskENTER_CRITICAL_FROM_ISR() };
+    chain->next_chain = d.full;
+    d.full = chain;
+    taskEXIT_CRITICAL_FROM_ISR(status);
+
+    ++g_stats[cls].flushes;
+}
+
+/* cache of the calling task, nullptr for ISRs and before the scheduler was started */
+task_cache* get_cache() {
+    if (xPortIsInsideInterrupt() == pdTRUE || ::xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return nullptr;
+    }
+
+    auto p_cache { static_cast<task_cache*>(::pvTaskGetThreadLocalStoragePointer(nullptr, SMALL_ALLOC_TLS_INDEX)) };
+    if (!p_cache) {
+        p_cache = static_cast<task_cache*>(depot_pop(CACHE_CLASS));
+        if (p_cache) {
+            std::memset(p_cache, 0, sizeof(task_cache));
+            ::vTaskSetThreadLocalStoragePointer(nullptr, SMALL_ALLOC_TLS_INDEX, p_cache);
+        }
+    }
+    return p_cache;
+}
+} // namespace
+
+void* small_alloc(size_t size) {
+    if (size > SMALL_ALLOC_MAX_SIZE) {
+        return ::_malloc_r(_impure_ptr, size);
+    }
+
+    const uint8_t cls { static_cast<uint8_t>(size ? (size - 1) / SMALL_ALLOC_GRANULE : 0) };
+    free_block* p_block {};
+
+    task_cache* const p_cache { get_cache() };
+    if (p_cache) {
+        magazine& mag { p_cache->magazines[cls] };
+        if (!mag.head) {
+            mag.head = refill(cls, mag.count);
+        }
+        p_block = mag.head;
+        if (p_block) {
+            mag.head = p_block->next;
+            --mag.count;
+        }
+    } else {
+        p_block = static_cast<free_block*>(depot_pop(cls));
+    }
+
+    if (!p_block) {
+        ++g_stats[cls].fallbacks;
+        return ::_malloc_r(_impure_ptr, size);
+    }
+
+    ++g_stats[cls].allocs;
+    return p_block;
+}
+
+void small_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    if (!in_arena(ptr)) {
+        ::_free_r(_impure_ptr, ptr);
+        return;
+    }
+
+    const uint8_t cls { class_of(ptr) };
+    auto p_block { static_cast<free_block*>(ptr) };
+    ++g_stats[cls].frees;
+
+    task_cache* const p_cache { get_cache() };
+    if (p_cache) {
+        magazine& mag { p_cache->magazines[cls] };
+        p_block->next = mag.head;
+        mag.head = p_block;
+        if (++mag.count >= 2 * SMALL_ALLOC_MAGAZINE_SIZE) {
+            flush(cls, mag);
+        }
+    } else {
+        depot_push(cls, p_block);
+    }
+}
+
+size_t small_alloc_size(const void* ptr) {
+    return in_arena(ptr) ? block_size(class_of(ptr)) : 0;
+}
+
+void small_alloc_release(TaskHandle_t task) {
+    auto p_cache { static_cast<task_cache*>(::pvTaskGetThreadLocalStoragePointer(task, SMALL_ALLOC_TLS_INDEX)) };
+    if (!p_cache) {
+        return;
+    }
+    ::vTaskSetThreadLocalStoragePointer(task, SMALL_ALLOC_TLS_INDEX, nullptr);
+
+    for (uint8_t cls {}; cls < SMALL_ALLOC_CLASSES; ++cls) {
+        /* walk the list, the count may be off by one if the task was deleted within small_alloc() or small_free() */
+        free_block* p_block { p_cache->magazines[cls].head };
+        while (p_block) {
+            free_block* const p_next { p_block->next };
+            depot_push(cls, p_block);
+            p_block = p_next;
+        }
+    }
+    depot_push(CACHE_CLASS, reinterpret_cast<free_block*>(p_cache));
+}
+
+bool get_small_alloc_stats(uint8_t size_class, small_alloc_stats& stats) {
+    if (size_class >= SMALL_ALLOC_CLASSES) {
+        return false;
+    }
+
+    const class_stats& s { g_stats[size_class] };
+    stats = { static_cast<uint16_t>(block_size(size_class)), s.pages, s.allocs.load(std::memory_order_relaxed), s.frees.load(std::memory_order_relaxed),
+        s.refills.load(std::memory_order_relaxed), s.flushes.load(std::memory_order_relaxed), s.fallbacks.load(std::memory_order_relaxed) };
+    return true;
+}
+} // namespace freertos
+
+extern "C" void vPortCleanUpTCB(void* tcb) {
+    freertos::small_alloc_release(static_cast<TaskHandle_t>(tcb));
+}
+
+void* operator new(size_t size) {
+    void* const ptr { freertos::small_alloc(size) };
+    if (!ptr) {
+        /* throws or aborts if exceptions are disabled */
+        std::__throw_bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return freertos::small_alloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return freertos::small_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    freertos::small_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    freertos::small_free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    freertos::small_free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    freertos::small_free(ptr);
+}
+
+#if configSMALL_OBJECT_ALLOCATOR_MALLOC == 1
+extern "C" {
+/* newlib calls the _r functions internally, so its own allocations stay with the heap */
+void* malloc(size_t size) {
+    return freertos::small_alloc(size);
+}
+
+void free(void* ptr) {
+    freertos::small_free(ptr);
+}
+
+void* realloc(void* ptr, size_t size) {
+    if (!ptr) {
+        return freertos::small_alloc(size);
+    }
+
+    const size_t old_size { freertos::small_alloc_size(ptr) };
+    if (!old_size) {
+        return ::_realloc_r(_impure_ptr, ptr, size);
+    }
+    if (!size) {
+        freertos::small_free(ptr);
+        return nullptr;
+    }
+    if (size <= old_size) {
+        return ptr;
+    }
+
+    void* const p_new { freertos::small_alloc(size) };
+    if (p_new) {
+        std::memcpy(p_new, ptr, old_size);
+        freertos::small_free(ptr);
+    }
+    return p_new;
+}
+} // extern C
+#endif // configSMALL_OBJECT_ALLOCATOR_MALLOC
+#endif // configUSE_SMALL_OBJECT_ALLOCATOR
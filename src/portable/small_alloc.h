@@ -0,0 +1,96 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    small_alloc.h
+ * @brief   Small object allocator with per-task caches
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+
+namespace freertos {
+static constexpr size_t SMALL_ALLOC_GRANULE { 16 };
+static constexpr uint8_t SMALL_ALLOC_CLASSES { 8 }; /**< Size classes from 16 to 128 byte */
+static constexpr size_t SMALL_ALLOC_MAX_SIZE { SMALL_ALLOC_GRANULE * SMALL_ALLOC_CLASSES };
+static constexpr uint16_t SMALL_ALLOC_MAGAZINE_SIZE { 16 }; /**< Number of blocks exchanged between a task cache and the depot at once */
+static constexpr size_t SMALL_ALLOC_PAGE_SIZE { 1'024 };
+static constexpr size_t SMALL_ALLOC_ARENA_SIZE { 32 * 1'024 };
+static constexpr uint8_t SMALL_ALLOC_TLS_INDEX { 1 }; /**< Thread local storage pointer of the task caches, index 0 is used by std::thread */
+
+/**
+ * @brief Statistics of a size class
+ */
+struct small_alloc_stats {
+    uint16_t size; /**< Block size in byte */
+    uint16_t pages; /**< Pages of the arena assigned to the size class */
+    uint32_t allocs; /**< Number of blocks allocated */
+    uint32_t frees; /**< Number of blocks freed */
+    uint32_t refills; /**< Number of task cache refills from the depot, each takes the lock once */
+    uint32_t flushes; /**< Number of magazines given back from a task cache to the depot */
+    uint32_t fallbacks; /**< Number of allocations served by malloc() because the arena was exhausted */
+};
+
+/**
+ * @brief Allocate memory, blocks up to SMALL_ALLOC_MAX_SIZE come from the per-task cache
+ * @param[in] size: Size in byte
+ * @return Pointer to the memory, aligned to SMALL_ALLOC_GRANULE for small blocks, or nullptr
+ * @note Small blocks are taken from the cache of the calling task without a lock. An empty cache is refilled with a magazine of blocks from the
+ *       global depot, which takes a short critical section. Larger sizes, ISRs, calls before the scheduler was started and an exhausted arena
+ *       use malloc().
+ */
+void* small_alloc(size_t size);
+
+/**
+ * @brief Free memory returned by small_alloc() or malloc()
+ * @param[in] ptr: Pointer to the memory, may be nullptr
+ * @note Small blocks go to the cache of the calling task, or to the depot if called from an ISR. A cache holding 2 * SMALL_ALLOC_MAGAZINE_SIZE
+ *       blocks of a size class gives a magazine back to the depot.
+ */
+void small_free(void* ptr);
+
+/**
+ * @brief Get the usable size of a small block
+ * @param[in] ptr: Pointer returned by small_alloc()
+ * @return Size of the block in byte or 0 if ptr was allocated by malloc()
+ */
+size_t small_alloc_size(const void* ptr);
+
+/**
+ * @brief Give all cached blocks of a task back to the depot
+ * @param[in] task: Handle of the task, the task must not run any more
+ * @note Called by the kernel when a task is deleted (portCLEAN_UP_TCB)
+ */
+void small_alloc_release(TaskHandle_t task);
+
+/**
+ * @brief Get the statistics of a size class
+ * @param[in] size_class: Index of the size class, 0 to SMALL_ALLOC_CLASSES - 1
+ * @param[out] stats: Statistics
+ * @return true on success, false if size_class is invalid
+ */
+bool get_small_alloc_stats(uint8_t size_class, small_alloc_stats& stats);
+} // namespace freertos
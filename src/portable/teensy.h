@@ -115,6 +115,28 @@ std::tuple<size_t, size_t> ram3_usage();
  */
 void print_ram_usage();
 
+/**
+ * @brief Free a heap block from an ISR
+ * @param[in] ptr: Block returned by malloc() or operator new, may be nullptr
+ * @note Lock-free, callable from any interrupt priority. The block is put on a deferred list that is freed as a whole by the next call to the
+ *       allocator, by drain_deferred_free() or by an idle job.
+ */
+void free_from_isr(void* ptr);
+
+/**
+ * @brief Free an array of heap blocks with a single lock acquisition
+ * @param[in] ptrs: Blocks returned by malloc() or operator new, entries may be nullptr
+ * @param[in] num: Number of blocks
+ * @note Not callable from an ISR
+ */
+void free_bulk(void* const* ptrs, size_t num);
+
+/**
+ * @brief Free the blocks deferred by free_from_isr()
+ * @note Not callable from an ISR
+ */
+void drain_deferred_free();
+
 /**
  * @brief Get the current time in microseconds
  * @return Current time in us
@@ -123,6 +145,12 @@ uint64_t get_us();
 
 uint64_t get_us_from_isr();
 
+/**
+ * @brief Read the RTC with the resolution of its 32.768 kHz clock
+ * @return RTC time in us since the epoch
+ */
+uint64_t get_rtc_us();
+
 /**
  * @brief Get the current time in milliseconds
  * @return Current time in ms
@@ -134,14 +162,50 @@ static inline uint32_t get_ms() {
 
 void print_stack_trace(TaskHandle_t task);
 
+/**
+ * @brief Wall clock derived from get_us(), disciplined to the RTC
+ * @note The time is calculated as base + (us - us_base) * rate with a cached Q32 rate. Corrections are applied by slewing the rate, so the clock
+ *       never goes backwards, unless it is set with step() or sync_rtc() finds an offset above CLOCK_STEP_THRESHOLD_US.
+ */
 class clock {
-    static timeval offset_;
-
 public:
+    static constexpr int64_t CLOCK_STEP_THRESHOLD_US { 1'000'000 }; /**< Larger offsets to the RTC are stepped by sync_rtc() */
+    static constexpr uint32_t CLOCK_MAX_SLEW_PPM { 500 }; /**< Rate change used to slew an offset */
+    static constexpr uint32_t CLOCK_MAX_DRIFT_PPM { 1'000 }; /**< Larger drift estimates are considered invalid */
+    static constexpr uint64_t CLOCK_DRIFT_INTERVAL_US { 16'000'000 }; /**< Minimum interval to estimate the drift */
+
+    /**
+     * @brief Synchronize the clock with the RTC
+     * @note Steps the clock on the first call, afterwards the drift of the CPU clock against the RTC is estimated from the time between the calls
+     *       and the remaining offset is slewed out. Should be called periodically, e.g. once per minute. Not callable from an ISR.
+     */
     static void sync_rtc();
 
-    static inline const timeval* get_offset() {
-        return &offset_;
-    }
+    /**
+     * @brief Get the current time
+     * @return Time since the epoch
+     * @note Lock-free, callable from tasks and ISRs
+     */
+    static timeval now();
+
+    /**
+     * @brief Set the clock, it may go backwards
+     * @param[in] time: New time since the epoch
+     * @note Not callable from an ISR
+     */
+    static void step(const timeval& time);
+
+    /**
+     * @brief Adjust the clock gradually by changing its rate for some time, like adjtime()
+     * @param[in] offset_us: Offset to add to the clock in us, replaces a slew still in progress
+     * @note Slews with CLOCK_MAX_SLEW_PPM, so an offset of 1 ms takes 2 s. Not callable from an ISR
+     */
+    static void slew(int64_t offset_us);
+
+    /**
+     * @brief Get the estimated drift of the CPU clock against the RTC
+     * @return Drift in parts per billion, positive if the CPU clock is slow
+     */
+    static int32_t drift_ppb();
 };
 } // namespace freertos
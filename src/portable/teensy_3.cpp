@@ -213,6 +213,16 @@ uint64_t get_us_from_isr() {
     return static_cast<uint64_t>(count) * 1'000U + current / (configCPU_CLOCK_HZ / configTICK_RATE_HZ / 1'000U);
 #endif
 }
+
+uint64_t get_rtc_us() {
+    uint32_t sec, prescaler;
+    do {
+        sec = RTC_TSR;
+        prescaler = RTC_TPR; // 32.768 kHz, carries into RTC_TSR at 32'768
+    } while (sec != RTC_TSR || prescaler != RTC_TPR);
+
+    return static_cast<uint64_t>(sec) * 1'000'000ULL + ((static_cast<uint64_t>(prescaler & 0x7fff) * 1'000'000ULL) >> 15);
+}
 } // namespace freertos
 
 extern "C" {
@@ -262,6 +262,23 @@ FASTRUN uint64_t get_us_from_isr() {
 
     return static_cast<uint64_t>(smc) * 1'000ULL + frac;
 }
+
+uint64_t get_rtc_us() {
+    uint32_t hi1 { SNVS_HPRTCMR };
+    uint32_t lo1 { SNVS_HPRTCLR };
+    while (true) {
+        const uint32_t hi2 { SNVS_HPRTCMR };
+        const uint32_t lo2 { SNVS_HPRTCLR };
+        if (lo1 == lo2 && hi1 == hi2) {
+            break;
+        }
+        hi1 = hi2;
+        lo1 = lo2;
+    }
+
+    const uint64_t ticks { (static_cast<uint64_t>(hi1) << 32) | lo1 }; // 32.768 kHz
+    return (ticks >> 15) * 1'000'000ULL + (((ticks & 0x7fff) * 1'000'000ULL) >> 15);
+}
 } // namespace freertos
 
 extern "C" {
@@ -35,6 +35,8 @@
 #include "avr/pgmspace.h"
 #include "teensy.h"
 #include "event_responder_support.h"
+#include "idle_jobs.h"
+#include "rcu.h"
 
 
 #if !(defined ARDUINO_TEENSY40 || defined ARDUINO_TEENSY41 || defined ARDUINO_TEENSY_MICROMOD || defined __MK64FX512__ || defined __MK66FX1M0__)
@@ -237,7 +239,94 @@ FLASHMEM void mcu_shutdown() {
 
 
 namespace freertos {
-timeval clock::offset_ { 0, 0 };
+namespace {
+/* wall time at us since boot is base + scale(us - base_us, rate) up to slew_end, base + slew_wall + scale(us - slew_end, drift) afterwards */
+struct clock_params {
+    uint64_t base_us;
+    int64_t base_sec;
+    uint32_t base_usec;
+    int32_t rate; /**< Q32 rate correction while slewing */
+    int32_t drift; /**< Q32 rate correction after slewing */
+    uint64_t slew_end;
+    uint64_t slew_wall; /**< Wall time passed from base to slew_end in us */
+};
+
+/* double buffered for lock-free readers: writers only change the inactive copy, then switch by incrementing g_clock_generation */
+clock_params g_clock_params[2];
+volatile uint32_t g_clock_generation;
+
+/* writer state, protected by critical sections */
+bool g_clock_synced;
+bool g_clock_drift_valid;
+uint64_t g_clock_ref_us;
+uint64_t g_clock_ref_rtc;
+
+constexpr int32_t ppm_to_q32(uint32_t ppm) {
+    return static_cast<int32_t>((static_cast<uint64_t>(ppm) << 32) / 1'000'000U);
+}
+
+/* d * rate / 2^32 for any d */
+inline int64_t rate_correction(uint64_t d, int32_t rate) {
+    return static_cast<int64_t>(d >> 32) * rate + ((static_cast<int64_t>(d & 0xffff'ffffU) * rate) >> 32);
+}
+
+inline uint64_t wall_delta(const clock_params& p, uint64_t now_us) {
+    if (now_us <= p.slew_end) {
+        const uint64_t d { now_us - p.base_us };
+        return d + rate_correction(d, p.rate);
+    }
+    const uint64_t d { now_us - p.slew_end };
+    return p.slew_wall + d + rate_correction(d, p.drift);
+}
+
+inline timeval to_timeval(const clock_params& p, uint64_t now_us) {
+    const uint64_t usec { wall_delta(p, now_us) + p.base_usec };
+    if (usec <= UINT32_MAX) {
+        /* avoid the 64 bit division as long as the clock was rebased within the last hour */
+        const uint32_t usec32 { static_cast<uint32_t>(usec) };
+        return { static_cast<time_t>(p.base_sec + usec32 / 1'000'000U), static_cast<suseconds_t>(usec32 % 1'000'000U) };
+    }
+    return { static_cast<time_t>(p.base_sec + static_cast<int64_t>(usec / 1'000'000U)), static_cast<suseconds_t>(usec % 1'000'000U) };
+}
+
+/* must be called in a critical section */
+inline const clock_params& current_params() {
+    return g_clock_params[g_clock_generation & 1];
+}
+
+/* must be called in a critical section */
+void publish(const clock_params& params) {
+    g_clock_params[(g_clock_generation + 1) & 1] = params;
+    portMEMORY_BARRIER();
+    g_clock_generation = g_clock_generation + 1;
+}
+
+/* continue the current time at now_us with a new rate, must be called in a critical section */
+clock_params rebase(uint64_t now_us, int32_t drift) {
+    const timeval now { to_timeval(current_params(), now_us) };
+    return { now_us, now.tv_sec, static_cast<uint32_t>(now.tv_usec), drift, drift, now_us, 0 };
+}
+
+/* must be called in a critical section */
+void set_slew(clock_params& params, int64_t offset_us) {
+    if (!offset_us) {
+        return;
+    }
+    constexpr int32_t SLEW { ppm_to_q32(clock::CLOCK_MAX_SLEW_PPM) };
+    const uint64_t abs_offset { static_cast<uint64_t>(offset_us < 0 ? -offset_us : offset_us) };
+    const uint64_t duration { (abs_offset << 32) / SLEW };
+
+    params.rate = params.drift + (offset_us < 0 ? -SLEW : SLEW);
+    params.slew_end = params.base_us + duration;
+    params.slew_wall = duration + rate_correction(duration, params.rate);
+}
+
+/* must be called in a critical section */
+void step_to(uint64_t now_us, uint64_t time_us) {
+    const int32_t drift { current_params().drift };
+    publish({ now_us, static_cast<int64_t>(time_us / 1'000'000U), static_cast<uint32_t>(time_us % 1'000'000U), drift, drift, now_us, 0 });
+}
+} // namespace
 
 FLASHMEM void error_blink(const uint8_t n) {
     ::vTaskSuspendAll();
@@ -272,18 +361,87 @@ FLASHMEM void print_ram_usage() {
 void clock::sync_rtc() {
     taskENTER_CRITICAL();
 
-    const auto now_us { freertos::get_us() };
-    const timeval now { static_cast<time_t>(now_us / 1'000'000UL), static_cast<suseconds_t>(now_us % 1'000'000UL) };
-    const timeval rtc { static_cast<time_t>(::rtc_get()), 0 };
+    const uint64_t rtc { get_rtc_us() };
+    const uint64_t now_us { get_us() };
+
+    if (!g_clock_synced) {
+        step_to(now_us, rtc);
+        g_clock_synced = true;
+        g_clock_ref_us = now_us;
+        g_clock_ref_rtc = rtc;
+        taskEXIT_CRITICAL();
+        return;
+    }
+
+    int32_t drift { current_params().drift };
+    const uint64_t interval { now_us - g_clock_ref_us };
+    if (interval >= CLOCK_DRIFT_INTERVAL_US) {
+        const int64_t diff { static_cast<int64_t>(rtc - g_clock_ref_rtc) - static_cast<int64_t>(interval) };
+        const uint64_t abs_diff { static_cast<uint64_t>(diff < 0 ? -diff : diff) };
+
+        /* a larger difference means the RTC was set in between */
+        if (abs_diff <= interval / 1'000'000U * CLOCK_MAX_DRIFT_PPM) {
+            const int32_t measured { static_cast<int32_t>(diff * (INT64_C(1) << 32) / static_cast<int64_t>(interval)) };
+            drift = g_clock_drift_valid ? drift + (measured - drift) / 4 : measured;
+            g_clock_drift_valid = true;
+        }
+        g_clock_ref_us = now_us;
+        g_clock_ref_rtc = rtc;
+    }
 
-    if (timercmp(&now, &rtc, <)) {
-        timersub(&rtc, &now, &offset_);
+    clock_params params { rebase(now_us, drift) };
+    const int64_t wall { params.base_sec * 1'000'000 + params.base_usec };
+    const int64_t offset { static_cast<int64_t>(rtc) - wall };
+
+    if (offset > CLOCK_STEP_THRESHOLD_US || offset < -CLOCK_STEP_THRESHOLD_US) {
+        step_to(now_us, rtc);
+        g_clock_ref_us = now_us;
+        g_clock_ref_rtc = rtc;
     } else {
-        timersub(&now, &rtc, &offset_);
+        set_slew(params, offset);
+        publish(params);
     }
 
     taskEXIT_CRITICAL();
 }
+
+timeval clock::now() {
+    uint32_t generation;
+    clock_params params;
+    uint64_t now_us;
+
+    /* an ISR interrupting a writer sees the old copy unchanged, a task retries if a writer ran in between */
+    do {
+        generation = g_clock_generation;
+        params = g_clock_params[generation & 1];
+        now_us = get_us();
+        portMEMORY_BARRIER();
+    } while (generation != g_clock_generation);
+
+    return to_timeval(params, now_us);
+}
+
+void clock::step(const timeval& time) {
+    taskENTER_CRITICAL();
+    step_to(get_us(), static_cast<uint64_t>(time.tv_sec) * 1'000'000U + time.tv_usec);
+    taskEXIT_CRITICAL();
+}
+
+void clock::slew(int64_t offset_us) {
+    taskENTER_CRITICAL();
+    clock_params params { rebase(get_us(), current_params().drift) };
+    set_slew(params, offset_us);
+    publish(params);
+    taskEXIT_CRITICAL();
+}
+
+int32_t clock::drift_ppb() {
+    taskENTER_CRITICAL();
+    const int32_t drift { current_params().drift };
+    taskEXIT_CRITICAL();
+
+    return static_cast<int32_t>((static_cast<int64_t>(drift) * 1'000'000'000) >> 32);
+}
 } // namespace freertos
 
 extern "C" {
@@ -311,7 +469,12 @@ FLASHMEM void yield() {
 }
 
 #if configUSE_IDLE_HOOK == 1
-void vApplicationIdleHook() {}
+void vApplicationIdleHook() {
+#if configUSE_RCU == 1
+    freertos::rcu::quiescent_state();
+#endif
+    freertos::run_idle_jobs();
+}
 #endif // configUSE_IDLE_HOOK
 
 void vApplicationStackOverflowHook(TaskHandle_t, char*) FLASHMEM;
@@ -377,13 +540,8 @@ void* _sbrk(ptrdiff_t incr) {
 };
 #endif // PLATFORMIO || TEENSYDUINO >= 158
 
-FLASHMEM int _gettimeofday(timeval* tv, void*) {
-    const auto p_offset { freertos::clock::get_offset() };
-
-    const auto now_us { freertos::get_us() };
-    const timeval now { static_cast<time_t>(now_us / 1'000'000UL), static_cast<suseconds_t>(now_us % 1'000'000UL) };
-
-    timeradd(p_offset, &now, tv);
+int _gettimeofday(timeval* tv, void*) {
+    *tv = freertos::clock::now();
     return 0;
 }
 
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    threaded_irq.cpp
+ * @brief   Interrupt handlers running in a task, similar to request_threaded_irq() of Linux
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "threaded_irq.h"
+#include "arduino_freertos.h"
+
+#include <new>
+
+
+namespace freertos {
+namespace {
+struct irq_thread {
+    uint8_t irq;
+    irq_handler_t handler;
+    void* arg;
+    void (*previous_vector)();
+    TaskHandle_t task;
+    volatile uint32_t raised; /**< Cycle counter value at the last interrupt */
+    threaded_irq_stats stats;
+};
+
+irq_thread* g_irq_threads[NVIC_NUM_INTERRUPTS];
+
+inline uint32_t active_exception() {
+    uint32_t ipsr;
+    __asm volatile("mrs %0, ipsr" : "=r"(ipsr));
+    return ipsr & 0x1ff;
+}
+
+/* generic top half, installed as vector of all threaded interrupts */
+FASTRUN void irq_top_half() {
+    const uint32_t irq { active_exception() - 16 };
+    irq_thread* const p_thread { g_irq_threads[irq] };
+
+    NVIC_DISABLE_IRQ(irq);
+    p_thread->raised = ARM_DWT_CYCCNT;
+
+    BaseType_t higher_woken { pdFALSE };
+    ::vTaskNotifyGiveFromISR(p_thread->task, &higher_woken);
+    portYIELD_FROM_ISR(higher_woken);
+    portDATA_SYNC_BARRIER(); // mitigate arm errata #838869
+}
+
+void irq_bottom_half(void* param) {
+    irq_thread& thread { *static_cast<irq_thread*>(param) };
+
+    while (true) {
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        const uint32_t start { ARM_DWT_CYCCNT };
+        thread.handler(thread.arg);
+        const uint32_t end { ARM_DWT_CYCCNT };
+
+        taskENTER_CRITICAL();
+        const uint32_t latency { start - thread.raised };
+        ++thread.stats.count;
+        thread.stats.last_latency = latency;
+        if (latency > thread.stats.max_latency) {
+            thread.stats.max_latency = latency;
+        }
+        thread.stats.total_runtime += end - start;
+        if (end - start > thread.stats.max_runtime) {
+            thread.stats.max_runtime = end - start;
+        }
+        taskEXIT_CRITICAL();
+
+        NVIC_ENABLE_IRQ(thread.irq);
+    }
+}
+} // namespace
+
+FLASHMEM bool request_threaded_irq(uint8_t irq, irq_handler_t handler, void* arg, uint32_t priority, const char* name, uint16_t stack_size) {
+    configASSERT(irq < NVIC_NUM_INTERRUPTS);
+    configASSERT(handler);
+
+    if (g_irq_threads[irq]) {
+        return false;
+    }
+
+    auto p_thread { new (std::nothrow) irq_thread { irq, handler, arg, nullptr, nullptr, 0, {} } };
+    if (!p_thread) {
+        return false;
+    }
+
+    if (::xTaskCreate(irq_bottom_half, name, stack_size, p_thread, priority, &p_thread->task) != pdPASS) {
+        delete p_thread;
+        return false;
+    }
+
+    NVIC_DISABLE_IRQ(irq);
+    /* the top half uses the FreeRTOS API */
+    if (NVIC_GET_PRIORITY(irq) < configMAX_SYSCALL_INTERRUPT_PRIORITY) {
+        NVIC_SET_PRIORITY(irq, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+    }
+
+    taskENTER_CRITICAL();
+    g_irq_threads[irq] = p_thread;
+    p_thread->previous_vector = _VectorsRam[irq + 16];
+    _VectorsRam[irq + 16] = irq_top_half;
+    taskEXIT_CRITICAL();
+
+    portDATA_SYNC_BARRIER();
+    NVIC_ENABLE_IRQ(irq);
+
+    return true;
+}
+
+FLASHMEM void free_threaded_irq(uint8_t irq) {
+    configASSERT(irq < NVIC_NUM_INTERRUPTS);
+
+    NVIC_DISABLE_IRQ(irq);
+
+    taskENTER_CRITICAL();
+    irq_thread* const p_thread { g_irq_threads[irq] };
+    if (p_thread) {
+        /* a bottom half of higher priority with a pending notification must not run and unmask the line again */
+        ::vTaskSuspend(p_thread->task);
+        _VectorsRam[irq + 16] = p_thread->previous_vector;
+        g_irq_threads[irq] = nullptr;
+    }
+    taskEXIT_CRITICAL();
+
+    if (p_thread) {
+        ::vTaskDelete(p_thread->task);
+        delete p_thread;
+    }
+}
+
+bool get_threaded_irq_stats(uint8_t irq, threaded_irq_stats& stats) {
+    bool found { false };
+
+    taskENTER_CRITICAL();
+    if (irq < NVIC_NUM_INTERRUPTS && g_irq_threads[irq]) {
+        stats = g_irq_threads[irq]->stats;
+        found = true;
+    }
+    taskEXIT_CRITICAL();
+
+    return found;
+}
+} // namespace freertos
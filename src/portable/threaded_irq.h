@@ -0,0 +1,74 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    threaded_irq.h
+ * @brief   Interrupt handlers running in a task, similar to request_threaded_irq() of Linux
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+
+namespace freertos {
+/**
+ * @brief Runtime statistics of a threaded interrupt, times in CPU cycles
+ */
+struct threaded_irq_stats {
+    uint32_t count; /**< Number of handler runs */
+    uint32_t last_latency; /**< Time from the interrupt to the start of the handler, last run */
+    uint32_t max_latency; /**< Time from the interrupt to the start of the handler, worst case */
+    uint64_t total_runtime; /**< Runtime of the handler, sum of all runs */
+    uint32_t max_runtime; /**< Runtime of the handler, worst case */
+};
+
+using irq_handler_t = void (*)(void*);
+
+/**
+ * @brief Run the handler of an interrupt in a task
+ * @param[in] irq: Number of the interrupt (IRQ_NUMBER_t)
+ * @param[in] handler: Handler to call for each interrupt, it has to clear the interrupt source
+ * @param[in] arg: Argument passed to handler
+ * @param[in] priority: RTOS priority of the handler task
+ * @param[in] name: Name of the handler task
+ * @param[in] stack_size: Stack size of the handler task in words
+ * @return true on success, false if the interrupt is already threaded or no memory is available
+ * @note The vector of the interrupt is replaced by a generic handler that masks the interrupt in the NVIC and notifies the task. The interrupt is
+ *       unmasked again when the handler returns. If the NVIC priority of the interrupt is above configMAX_SYSCALL_INTERRUPT_PRIORITY, it is lowered
+ *       to that value.
+ */
+bool request_threaded_irq(uint8_t irq, irq_handler_t handler, void* arg, uint32_t priority, const char* name, uint16_t stack_size = 256);
+
+/**
+ * @brief Restore the previous vector of a threaded interrupt and delete its handler task
+ * @param[in] irq: Number of the interrupt
+ * @note The interrupt is left disabled. Must not be called from the handler itself
+ */
+void free_threaded_irq(uint8_t irq);
+
+/**
+ * @brief Get the runtime statistics of a threaded interrupt
+ * @param[in] irq: Number of the interrupt
+ * @param[out] stats: Statistics
+ * @return true on success, false if the interrupt is not threaded
+ */
+bool get_threaded_irq_stats(uint8_t irq, threaded_irq_stats& stats);
+} // namespace freertos
@@ -0,0 +1,48 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    timer.cpp
+ * @brief   C++ wrapper for software timers without dynamic memory allocation
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#include "timer.h"
+
+#if configUSE_TIMERS == 1 && configSUPPORT_STATIC_ALLOCATION == 1
+
+namespace freertos {
+timer::~timer() {
+    configASSERT(::xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED);
+    configASSERT(::xTaskGetCurrentTaskHandle() != ::xTimerGetTimerDaemonTaskHandle());
+
+    xTimerDelete(handle_, portMAX_DELAY);
+
+    /* the timer task processes its commands in order, so buffer_ is no longer used when this function is called */
+    ::xTimerPendFunctionCall(
+        [](void* p_task, uint32_t index) { ::xTaskNotifyGiveIndexed(static_cast<TaskHandle_t>(p_task), index); }, ::xTaskGetCurrentTaskHandle(),
+        NOTIFICATION_INDEX, portMAX_DELAY);
+    ::ulTaskNotifyTakeIndexed(NOTIFICATION_INDEX, pdTRUE, portMAX_DELAY);
+
+    if (destroy_) {
+        destroy_(storage_);
+    }
+}
+} // namespace freertos
+#endif // configUSE_TIMERS == 1 && configSUPPORT_STATIC_ALLOCATION == 1
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    timer.h
+ * @brief   C++ wrapper for software timers without dynamic memory allocation
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#if configUSE_TIMERS == 1 && configSUPPORT_STATIC_ALLOCATION == 1
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace freertos {
+/**
+ * @brief Software timer with static storage, the callable is stored inside the object
+ * @note The object must not be destroyed from a timer callback (timer service task) or before the scheduler was started
+ */
+class timer {
+public:
+    static constexpr size_t CALLABLE_SIZE { 4 * sizeof(void*) }; /**< Maximum size of the callable, e.g. a lambda capturing 4 pointers */
+    static constexpr UBaseType_t NOTIFICATION_INDEX { configTIMER_NOTIFICATION_INDEX }; /**< Used by the destructor to wait for the timer task */
+    static_assert(NOTIFICATION_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 && NOTIFICATION_INDEX != configSTOP_STATE_NOTIFICATION_INDEX,
+        "configTIMER_NOTIFICATION_INDEX must be a reserved index of its own");
+
+    /**
+     * @brief Create a timer, it is not started
+     * @param[in] name: Name of the timer
+     * @param[in] period: Period of the timer, rounded up to full ticks
+     * @param[in] auto_reload: true for a periodic timer, false for a one-shot timer
+     * @param[in] callback: Callable without arguments, called in the context of the timer task
+     */
+    template <typename Rep, typename Period, typename F>
+    timer(const char* name, const std::chrono::duration<Rep, Period>& period, const bool auto_reload, F&& callback) {
+        using callable_t = std::decay_t<F>;
+        static_assert(sizeof(callable_t) <= CALLABLE_SIZE, "callable too big, capture less or by reference");
+        static_assert(alignof(callable_t) <= alignof(std::max_align_t), "callable alignment not supported");
+        static_assert(std::is_invocable_v<callable_t&>, "callable must be invocable without arguments");
+
+        ::new (storage_) callable_t(std::forward<F>(callback));
+        invoke_ = [](void* p_callable) { (*static_cast<callable_t*>(p_callable))(); };
+        if constexpr (!std::is_trivially_destructible_v<callable_t>) {
+            destroy_ = [](void* p_callable) { static_cast<callable_t*>(p_callable)->~callable_t(); };
+        }
+
+        handle_ = ::xTimerCreateStatic(name, to_ticks(period), auto_reload, this, &callback_wrapper, &buffer_);
+        configASSERT(handle_);
+    }
+
+    /**
+     * @brief Stop and delete the timer, waits until the timer task has processed the deletion
+     */
+    ~timer();
+
+    timer(const timer&) = delete;
+    timer(timer&&) = delete;
+    timer& operator=(const timer&) = delete;
+    timer& operator=(timer&&) = delete;
+
+    bool start(const TickType_t ticks_to_wait = portMAX_DELAY) {
+        return xTimerStart(handle_, ticks_to_wait) == pdPASS;
+    }
+
+    bool stop(const TickType_t ticks_to_wait = portMAX_DELAY) {
+        return xTimerStop(handle_, ticks_to_wait) == pdPASS;
+    }
+
+    /**
+     * @brief (Re-)start the timer, the period starts at the time of the call
+     */
+    bool reset(const TickType_t ticks_to_wait = portMAX_DELAY) {
+        return xTimerReset(handle_, ticks_to_wait) == pdPASS;
+    }
+
+    /**
+     * @brief Change the period of the timer, starts the timer if it is not running
+     */
+    template <typename Rep, typename Period>
+    bool set_period(const std::chrono::duration<Rep, Period>& period, const TickType_t ticks_to_wait = portMAX_DELAY) {
+        return xTimerChangePeriod(handle_, to_ticks(period), ticks_to_wait) == pdPASS;
+    }
+
+    bool start_from_isr(BaseType_t* p_higher_prio_woken) {
+        return xTimerStartFromISR(handle_, p_higher_prio_woken) == pdPASS;
+    }
+
+    bool stop_from_isr(BaseType_t* p_higher_prio_woken) {
+        return xTimerStopFromISR(handle_, p_higher_prio_woken) == pdPASS;
+    }
+
+    bool reset_from_isr(BaseType_t* p_higher_prio_woken) {
+        return xTimerResetFromISR(handle_, p_higher_prio_woken) == pdPASS;
+    }
+
+    bool active() const {
+        return ::xTimerIsTimerActive(handle_) != pdFALSE;
+    }
+
+    TickType_t period() const {
+        return ::xTimerGetPeriod(handle_);
+    }
+
+    TickType_t expiry_time() const {
+        return ::xTimerGetExpiryTime(handle_);
+    }
+
+    TimerHandle_t native_handle() const {
+        return handle_;
+    }
+
+    template <typename Rep, typename Period>
+    static constexpr TickType_t to_ticks(const std::chrono::duration<Rep, Period>& duration) {
+        using tick_duration = std::chrono::duration<TickType_t, std::ratio<1, configTICK_RATE_HZ>>;
+        const TickType_t ticks { std::chrono::ceil<tick_duration>(duration).count() };
+        return ticks ? ticks : 1;
+    }
+
+private:
+    static void callback_wrapper(TimerHandle_t handle) {
+        static_assert(std::is_standard_layout_v<timer>);
+        /* buffer_ is the first member, so no need to read the timer ID in a critical section */
+        timer* const p_timer { reinterpret_cast<timer*>(handle) };
+        p_timer->invoke_(p_timer->storage_);
+    }
+
+    StaticTimer_t buffer_;
+    TimerHandle_t handle_;
+    void (*invoke_)(void*);
+    void (*destroy_)(void*) {};
+    alignas(std::max_align_t) std::byte storage_[CALLABLE_SIZE];
+};
+} // namespace freertos
+#endif // configUSE_TIMERS == 1 && configSUPPORT_STATIC_ALLOCATION == 1
@@ -0,0 +1,143 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    token_bucket.cpp
+ * @brief   Token bucket rate limiter, usable from tasks and ISRs
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#include "token_bucket.h"
+#include "teensy.h"
+#include "arduino_freertos.h"
+
+
+namespace freertos {
+namespace {
+inline uint64_t now_us() {
+    return xPortIsInsideInterrupt() ? get_us_from_isr() : get_us();
+}
+
+inline uint32_t epoch(uint64_t now) {
+    return static_cast<uint32_t>(now / token_bucket::HORIZON_US);
+}
+} // namespace
+
+token_bucket::token_bucket(uint32_t rate, uint32_t burst)
+    : interval_ { rate > 1'000'000U ? 1U : (1'000'000U + rate / 2) / (rate ? rate : 1) }, span_ { burst * interval_ }, tat_ {}, epoch_ {},
+      granted_ {}, dropped_ {}, waited_ {} {
+    configASSERT(rate && burst);
+    configASSERT(static_cast<uint64_t>(burst) * interval_ < HORIZON_US);
+
+    const uint64_t now { now_us() };
+    epoch_.store(epoch(now), std::memory_order_relaxed);
+    tat_.store(static_cast<uint32_t>(now), std::memory_order_release);
+}
+
+/* a tat_ is written at most HORIZON_US ahead of the time of writing. Two epochs later it is in the past for sure, before that it lies
+   within 2^31 us of now and the signed difference of the lower 32 bit is exact. */
+int32_t token_bucket::ahead(uint32_t tat, uint64_t now) const {
+    if (epoch(now) - epoch_.load(std::memory_order_relaxed) >= 2) {
+        return 0;
+    }
+
+    return static_cast<int32_t>(tat - static_cast<uint32_t>(now));
+}
+
+/* the bucket is full at tat_, each token moves it one interval into the future. A tat_ in the past means the bucket is full. The epoch
+   is published before tat_, so a reader seeing a new tat_ sees its epoch, too. */
+FASTRUN bool token_bucket::reserve(uint32_t tokens, uint64_t now, uint32_t limit, uint64_t& ready) {
+    if (tokens > span_ / interval_) {
+        return false;
+    }
+
+    uint32_t tat { tat_.load(std::memory_order_acquire) };
+    uint32_t new_ahead;
+    do {
+        const int32_t old_ahead { ahead(tat, now) };
+        new_ahead = (old_ahead > 0 ? old_ahead : 0) + tokens * interval_;
+        if (new_ahead > span_ + limit) {
+            return false;
+        }
+        epoch_.store(epoch(now), std::memory_order_relaxed);
+    } while (!tat_.compare_exchange_weak(tat, static_cast<uint32_t>(now) + new_ahead, std::memory_order_release, std::memory_order_acquire));
+
+    ready = now + (new_ahead > span_ ? new_ahead - span_ : 0);
+    return true;
+}
+
+FASTRUN bool token_bucket::try_acquire(uint32_t tokens) {
+    uint64_t ready;
+    if (!reserve(tokens, now_us(), 0, ready)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    granted_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool token_bucket::acquire(uint32_t tokens, TickType_t timeout) {
+    configASSERT(!xPortIsInsideInterrupt());
+
+    const uint64_t timeout_us { static_cast<uint64_t>(timeout) * 1'000'000U / configTICK_RATE_HZ };
+    const uint32_t limit { timeout_us < HORIZON_US - span_ ? static_cast<uint32_t>(timeout_us) : HORIZON_US - span_ };
+    uint64_t now { now_us() };
+    uint64_t ready;
+    if (!reserve(tokens, now, limit, ready)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    granted_.fetch_add(1, std::memory_order_relaxed);
+    if (ready <= now) {
+        return true;
+    }
+
+    waited_.fetch_add(1, std::memory_order_relaxed);
+    /* vTaskDelay() may return up to one tick early */
+    while (ready > now) {
+        const uint32_t ticks { static_cast<uint32_t>(((ready - now) * configTICK_RATE_HZ + 999'999U) / 1'000'000U) };
+        ::vTaskDelay(ticks);
+        now = now_us();
+    }
+
+    return true;
+}
+
+uint32_t token_bucket::available() const {
+    const uint64_t now { now_us() };
+    const int32_t time_ahead { ahead(tat_.load(std::memory_order_acquire), now) };
+    if (time_ahead <= 0) {
+        return span_ / interval_;
+    }
+
+    return static_cast<uint32_t>(time_ahead) < span_ ? (span_ - static_cast<uint32_t>(time_ahead)) / interval_ : 0;
+}
+
+token_bucket_stats token_bucket::get_stats(bool reset) {
+    if (reset) {
+        return { granted_.exchange(0, std::memory_order_relaxed), dropped_.exchange(0, std::memory_order_relaxed),
+            waited_.exchange(0, std::memory_order_relaxed) };
+    }
+
+    return { granted_.load(std::memory_order_relaxed), dropped_.load(std::memory_order_relaxed), waited_.load(std::memory_order_relaxed) };
+}
+} // namespace freertos
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    token_bucket.h
+ * @brief   Token bucket rate limiter, usable from tasks and ISRs
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#include <atomic>
+#include <cstdint>
+
+
+namespace freertos {
+/**
+ * @brief Statistics of a token bucket
+ */
+struct token_bucket_stats {
+    uint32_t granted; /**< Number of successful acquisitions */
+    uint32_t dropped; /**< Number of acquisitions denied or timed out */
+    uint32_t waited; /**< Number of successful acquisitions that had to sleep */
+};
+
+/**
+ * @brief Token bucket rate limiter, refilled continuously from the microsecond clock
+ * @note The bucket holds no lock, try_acquire() updates the time the bucket will be full again with a compare and swap. It may be called from
+ *       tasks and ISRs of any priority.
+ */
+class token_bucket {
+public:
+    static constexpr uint32_t HORIZON_US { 1U << 30 }; /**< Maximum time tokens can be reserved in advance by acquire() */
+
+    /**
+     * @brief Create a full bucket
+     * @param[in] rate: Tokens added per second, at most 1'000'000, the interval between tokens is rounded to full microseconds
+     * @param[in] burst: Capacity of the bucket in tokens
+     */
+    token_bucket(uint32_t rate, uint32_t burst);
+
+    token_bucket(const token_bucket&) = delete;
+    token_bucket& operator=(const token_bucket&) = delete;
+
+    /**
+     * @brief Take tokens if available, never blocks
+     * @param[in] tokens: Number of tokens to take
+     * @return true if the tokens were taken, false if not enough tokens are available
+     */
+    bool try_acquire(uint32_t tokens = 1);
+
+    /**
+     * @brief Take tokens, sleeping until they become available
+     * @param[in] tokens: Number of tokens to take
+     * @param[in] timeout: Maximum time to wait in ticks
+     * @return true if the tokens were taken, false if they will not be available within timeout
+     * @note The tokens are reserved before the calling task sleeps, so it does not compete with other callers when it wakes up. Returns
+     *       false immediately if the wait would exceed timeout. Must not be called from an ISR.
+     */
+    bool acquire(uint32_t tokens, TickType_t timeout);
+
+    /**
+     * @brief Get the number of tokens available right now
+     * @return Number of tokens
+     */
+    uint32_t available() const;
+
+    /**
+     * @brief Get the statistics of the bucket
+     * @param[in] reset: Reset the counters if true
+     * @return Statistics
+     */
+    token_bucket_stats get_stats(bool reset = false);
+
+private:
+    const uint32_t interval_; /**< Time between two tokens in us */
+    const uint32_t span_; /**< Time to refill a drained bucket in us */
+    std::atomic<uint32_t> tat_; /**< Lower 32 bit of get_us() at which the bucket is full again */
+    std::atomic<uint32_t> epoch_; /**< get_us() / HORIZON_US when tat_ was last written, tells a stale tat_ from one in the future */
+    std::atomic<uint32_t> granted_;
+    std::atomic<uint32_t> dropped_;
+    std::atomic<uint32_t> waited_;
+
+    bool reserve(uint32_t tokens, uint64_t now, uint32_t limit, uint64_t& ready);
+    int32_t ahead(uint32_t tat, uint64_t now) const;
+};
+} // namespace freertos
@@ -210,6 +210,20 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+/*
+ * If the queue is empty and the highest priority task waiting to receive from
+ * it published its buffer, copy the item directly into that buffer instead of
+ * into the queue storage area.  Returns pdTRUE if the item was handed off, the
+ * caller must then unblock the receiver.  Must be called from within a critical
+ * section.
+ */
+    static BaseType_t prvHandOffToReceiver( const Queue_t * const pxQueue,
+                                            const void * pvItemToQueue ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -251,6 +265,28 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_LOCK_STATS == 1 )
+
+/*
+ * The semaphore take without lock statistics.  xQueueSemaphoreTake() calls it
+ * directly for semaphores and through prvQueueTakeMutexWithStats() for
+ * mutexes.
+ */
+    static BaseType_t prvQueueSemaphoreTake( QueueHandle_t xQueue,
+                                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes a mutex and reports the acquisition to the port.  The mutex is tried
+ * without blocking first, so a take that has to wait is known to be contended.
+ * pvCallsite is the return address of the API function called by the
+ * application.
+ */
+    static BaseType_t prvQueueTakeMutexWithStats( Queue_t * const pxMutex,
+                                                  TickType_t xTicksToWait,
+                                                  void * pvCallsite ) PRIVILEGED_FUNCTION;
+#endif
+/*-----------------------------------------------------------*/
+
 /*
  * Macro to mark a queue as locked.  Locking a queue prevents an ISR from
  * accessing the queue event lists.
@@ -300,6 +336,15 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     } while( 0 )
 /*-----------------------------------------------------------*/
 
+/*
+ * Type of object a task blocking on pxQueue is recorded as blocked on, see
+ * vTaskSetBlockedOn().  Semaphores are queues with an item size of 0.
+ */
+#define prvGetBlockedOnType( pxQueue )                                   \
+    ( ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX ) ? eBlockedOnMutex : \
+      ( ( ( pxQueue )->uxItemSize == queueSEMAPHORE_QUEUE_ITEM_LENGTH ) ? eBlockedOnSemaphore : eBlockedOnQueue ) )
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                                BaseType_t xNewQueue )
 {
@@ -523,7 +568,13 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
+            #if ( configUSE_QUEUE_CACHE_LINE_ALIGNMENT == 1 )
+                /* Start the queue on a cache line, so the fields used by every
+                 * send and receive span as few cache lines as possible. */
+                pxNewQueue = ( Queue_t * ) pvPortMallocAligned( portCACHE_LINE_SIZE, sizeof( Queue_t ) + xQueueSizeInBytes );
+            #else
+                pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
+            #endif
 
             if( pxNewQueue != NULL )
             {
@@ -834,7 +885,15 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
         }
         else
         {
-            xReturn = xQueueSemaphoreTake( pxMutex, xTicksToWait );
+            #if ( configUSE_LOCK_STATS == 1 )
+            {
+                xReturn = prvQueueTakeMutexWithStats( pxMutex, xTicksToWait, portLOCK_STATS_CALLSITE() );
+            }
+            #else
+            {
+                xReturn = xQueueSemaphoreTake( pxMutex, xTicksToWait );
+            }
+            #endif
 
             /* pdPASS will only be returned if the mutex was successfully
              * obtained.  The calling task may have entered the Blocked state
@@ -968,6 +1027,34 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             {
                 traceQUEUE_SEND( pxQueue );
 
+                #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+                {
+                    if( prvHandOffToReceiver( pxQueue, pvItemToQueue ) != pdFALSE )
+                    {
+                        /* The receiver already has the item, the queue storage
+                         * was bypassed.  Unblock it now. */
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        taskEXIT_CRITICAL();
+
+                        traceRETURN_xQueueGenericSend( pdPASS );
+
+                        return pdPASS;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+
                 #if ( configUSE_QUEUE_SETS == 1 )
                 {
                     const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1113,6 +1200,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             if( prvIsQueueFull( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskSetBlockedOn( ( void * ) pxQueue, prvGetBlockedOnType( pxQueue ) );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 
                 /* Unlocking the queue means queue events can effect the
@@ -1523,6 +1611,21 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
         {
             const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
+            #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+                if( xTaskResetHandoffState() != pdFALSE )
+                {
+                    /* A sender copied the item directly into pvBuffer while
+                     * this task was blocked. */
+                    traceQUEUE_RECEIVE( pxQueue );
+                    taskEXIT_CRITICAL();
+
+                    traceRETURN_xQueueReceive( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+            #endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+
             /* Is there data in the queue now?  To be running the calling task
              * must be the highest priority task wanting to access the queue. */
             if( uxMessagesWaiting > ( UBaseType_t ) 0 )
@@ -1600,6 +1703,22 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+                {
+                    /* Let a sender copy the item directly into pvBuffer. */
+                    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+                    {
+                        vTaskSetHandoffBuffer( pvBuffer );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+
+                vTaskSetBlockedOn( ( void * ) pxQueue, prvGetBlockedOnType( pxQueue ) );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
@@ -1643,8 +1762,56 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
-                                TickType_t xTicksToWait )
+#if ( configUSE_LOCK_STATS == 1 )
+
+    BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                    TickType_t xTicksToWait )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( ( pxQueue ) );
+
+        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            return prvQueueTakeMutexWithStats( pxQueue, xTicksToWait, portLOCK_STATS_CALLSITE() );
+        }
+
+        return prvQueueSemaphoreTake( xQueue, xTicksToWait );
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvQueueTakeMutexWithStats( Queue_t * const pxMutex,
+                                                  TickType_t xTicksToWait,
+                                                  void * pvCallsite )
+    {
+        BaseType_t xReturn;
+        BaseType_t xContended = pdFALSE;
+        const uint32_t ulStartTime = portLOCK_STATS_TIME();
+
+        xReturn = prvQueueSemaphoreTake( pxMutex, 0 );
+
+        if( xReturn == pdFAIL )
+        {
+            xContended = pdTRUE;
+
+            if( xTicksToWait != ( TickType_t ) 0 )
+            {
+                xReturn = prvQueueSemaphoreTake( pxMutex, xTicksToWait );
+            }
+        }
+
+        vPortLockStatsTaken( ( void * ) pxMutex, pvCallsite, ulStartTime, xContended, xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvQueueSemaphoreTake( QueueHandle_t xQueue,
+                                             TickType_t xTicksToWait )
+#else /* if ( configUSE_LOCK_STATS == 1 ) */
+    BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                    TickType_t xTicksToWait )
+#endif /* if ( configUSE_LOCK_STATS == 1 ) */
 {
     BaseType_t xEntryTimeSet = pdFALSE;
     TimeOut_t xTimeOut;
@@ -1790,6 +1957,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
                 #endif /* if ( configUSE_MUTEXES == 1 ) */
 
+                vTaskSetBlockedOn( ( void * ) pxQueue, prvGetBlockedOnType( pxQueue ) );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
@@ -1983,6 +2151,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                vTaskSetBlockedOn( ( void * ) pxQueue, prvGetBlockedOnType( pxQueue ) );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
@@ -2393,6 +2562,12 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
             if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
             {
                 /* The mutex is no longer being held. */
+                #if ( configUSE_LOCK_STATS == 1 )
+                {
+                    vPortLockStatsGiven( ( void * ) pxQueue );
+                }
+                #endif
+
                 xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
                 pxQueue->u.xSemaphore.xMutexHolder = NULL;
             }
@@ -2405,7 +2580,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else if( xPosition == queueSEND_TO_BACK )
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+        ( void ) portMEMCPY( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
         pxQueue->pcWriteTo += pxQueue->uxItemSize;
 
         if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
@@ -2419,7 +2594,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+        ( void ) portMEMCPY( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
         pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
         if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead )
@@ -2474,11 +2649,52 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
             mtCOVERAGE_TEST_MARKER();
         }
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize );
+        ( void ) portMEMCPY( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize );
     }
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+    static BaseType_t prvHandOffToReceiver( const Queue_t * const pxQueue,
+                                            const void * pvItemToQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+        void * pvBuffer;
+
+        /* Items already in the queue must be received first.  Queues in a
+         * queue set must go through the storage area, the set is notified about
+         * the item, not the receiver. */
+        if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0 ) )
+        {
+            #if ( configUSE_QUEUE_SETS == 1 )
+                if( pxQueue->pxQueueSetContainer == NULL )
+            #endif
+            {
+                pvBuffer = pvTaskTakeHandoffBuffer( &( pxQueue->xTasksWaitingToReceive ) );
+
+                if( pvBuffer != NULL )
+                {
+                    ( void ) portMEMCPY( pvBuffer, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2830,7 +3046,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 }
 
                 --( pxQueue->uxMessagesWaiting );
-                ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+                ( void ) portMEMCPY( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
 
                 xReturn = pdPASS;
 
@@ -2952,7 +3168,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             }
 
             --( pxQueue->uxMessagesWaiting );
-            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+            ( void ) portMEMCPY( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
 
             if( ( *pxCoRoutineWoken ) == pdFALSE )
             {
@@ -3144,6 +3360,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0U )
         {
             /* There is nothing in the queue, block for the specified period. */
+            vTaskSetBlockedOn( ( void * ) pxQueue, prvGetBlockedOnType( pxQueue ) );
             vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait, xWaitIndefinitely );
         }
         else
@@ -177,6 +177,34 @@ typedef struct xTASK_STATUS
     #endif
 } TaskStatus_t;
 
+/* Kernel objects a task can be blocked on, used with xTaskGetStateStats(). */
+typedef enum
+{
+    eBlockedOnNothing = 0,  /* The task is not blocked. */
+    eBlockedOnDelay,        /* vTaskDelay(), xTaskDelayUntil() or any other block on time only. */
+    eBlockedOnNotification, /* ulTaskNotifyTake() or xTaskNotifyWait(). */
+    eBlockedOnQueue,
+    eBlockedOnSemaphore,
+    eBlockedOnMutex,        /* Mutexes and recursive mutexes. */
+    eBlockedOnEventGroup,
+    eBlockedOnStreamBuffer, /* Stream and message buffers. */
+    eBlockedOnChannel,
+    eBlockedOnNumTypes
+} eBlockedOnType;
+
+/* Used with the xTaskGetStateStats() function to return the time a task spent
+ * in each state, in units of the run time stats clock. */
+typedef struct xTASK_STATE_STATS
+{
+    void * pvBlockedOn;                                     /* The object the task is blocked on, NULL if it is not blocked or blocked on time only. */
+    eBlockedOnType eBlockedOn;                              /* The type of object the task is blocked on. */
+    configRUN_TIME_COUNTER_TYPE ulRunningTime;              /* Time spent in the Running state. */
+    configRUN_TIME_COUNTER_TYPE ulReadyTime;                /* Time spent in the Ready state waiting to be scheduled. */
+    configRUN_TIME_COUNTER_TYPE ulSuspendedTime;            /* Time spent in the Suspended state. */
+    configRUN_TIME_COUNTER_TYPE ulBlockedTime[ eBlockedOnNumTypes ]; /* Time spent in the Blocked state by object type, the eBlockedOnNothing entry is always 0. */
+    uint32_t ulReadyLatency[ configREADY_LATENCY_BUCKETS ]; /* Number of times the task was unblocked or resumed and started to run after a delay of less than 1 (entry 0) or of 2^(n-1) to 2^n - 1 (entry n) run time stats clock units.  The last entry counts all longer delays. */
+} TaskStateStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -1186,6 +1214,37 @@ UBaseType_t uxTaskBasePriorityGetFromISR( const TaskHandle_t xTask ) PRIVILEGED_
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetTimeSlice( TaskHandle_t xTask, TickType_t xTicks );
+ * TickType_t xTaskGetTimeSlice( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_TASK_TIME_SLICES must be defined as 1 for these functions to be
+ * available.
+ *
+ * Set or get the round robin quantum of a task.  While other tasks of the same
+ * priority are ready, the task is switched out after it ran for xTicks ticks.
+ * A quantum of 0 turns time slicing off for the task, it then runs until it
+ * blocks or yields.  New tasks get configTASK_TIME_SLICE_TICKS.  Use
+ * pdMS_TO_TICKS() to specify the quantum in milliseconds.
+ *
+ * With configTASK_TIME_SLICE_CARRY_OVER set to 1, the part of the quantum
+ * left when the task is preempted or blocks is used the next time it runs,
+ * otherwise the task gets a full quantum each time it is switched in.
+ *
+ * @param xTask Handle of the task, NULL for the calling task.
+ *
+ * @param xTicks The quantum in ticks.
+ *
+ * \defgroup vTaskSetTimeSlice vTaskSetTimeSlice
+ * \ingroup TaskCtrl
+ */
+void vTaskSetTimeSlice( TaskHandle_t xTask,
+                        TickType_t xTicks ) PRIVILEGED_FUNCTION;
+TickType_t xTaskGetTimeSlice( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -1732,6 +1791,61 @@ TickType_t xTaskGetTickCountFromISR( void ) PRIVILEGED_FUNCTION;
  */
 UBaseType_t uxTaskGetNumberOfTasks( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetNumberOfTasksPendingTermination( void );
+ * @endcode
+ *
+ * INCLUDE_vTaskDelete must be defined as 1 for this function to be available.
+ *
+ * @return The number of tasks that have deleted themselves, but whose TCB and
+ * stack have not yet been freed by the idle task (or the reaper task if
+ * configUSE_TASK_REAPER is set to 1).
+ *
+ * \defgroup uxTaskGetNumberOfTasksPendingTermination uxTaskGetNumberOfTasksPendingTermination
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetNumberOfTasksPendingTermination( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * size_t xTaskGetRecycleCacheBytes( void );
+ * @endcode
+ *
+ * configTASK_RECYCLE_CACHE_SIZE must be greater than 0 for this function to be
+ * available.
+ *
+ * The TCB and stack of up to configTASK_RECYCLE_CACHE_SIZE deleted tasks are
+ * kept and reused by xTaskCreate() for a new task with the same stack depth,
+ * instead of returning them to the heap.
+ *
+ * @return The number of bytes currently held by this cache and by deleted
+ * tasks waiting for their memory to be freed.
+ *
+ * \defgroup xTaskGetRecycleCacheBytes xTaskGetRecycleCacheBytes
+ * \ingroup TaskUtils
+ */
+size_t xTaskGetRecycleCacheBytes( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskRecycleCacheFlush( void );
+ * @endcode
+ *
+ * configTASK_RECYCLE_CACHE_SIZE must be greater than 0 for this function to be
+ * available.
+ *
+ * Return all TCBs and stacks held by the recycle cache to the heap, e.g. if a
+ * task with a different stack depth could not be created.
+ *
+ * \defgroup vTaskRecycleCacheFlush vTaskRecycleCacheFlush
+ * \ingroup TaskUtils
+ */
+void vTaskRecycleCacheFlush( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -1747,6 +1861,24 @@ UBaseType_t uxTaskGetNumberOfTasks( void ) PRIVILEGED_FUNCTION;
  */
 char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetName( TaskHandle_t xTaskToRename, const char *pcNewName );
+ * @endcode
+ *
+ * Change the text (human readable) name of the task referenced by the handle
+ * xTaskToRename.  A task can rename itself by passing NULL as handle.  The
+ * name is truncated to configMAX_TASK_NAME_LEN - 1 characters.  Always use
+ * this function instead of writing to the buffer returned by pcTaskGetName(),
+ * otherwise xTaskGetHandle() can't find the task by its new name.
+ *
+ * \defgroup vTaskSetName vTaskSetName
+ * \ingroup TaskUtils
+ */
+void vTaskSetName( TaskHandle_t xTaskToRename,
+                   const char * pcNewName ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -1754,7 +1886,8 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
  * @endcode
  *
  * NOTE:  This function takes a relatively long time to complete and should be
- * used sparingly.
+ * used sparingly.  If configUSE_TASK_NAME_INDEX is set to 1, the task is looked
+ * up in a hash table instead, which is fast and doesn't suspend the scheduler.
  *
  * @return The handle of the task that has the human readable name pcNameToQuery.
  * NULL is returned if no matching name is found.  INCLUDE_xTaskGetHandle
@@ -2076,6 +2209,26 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
     TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
 #endif /* #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) */
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskIdleShouldYield( void );
+ * @endcode
+ *
+ * configUSE_IDLE_HOOK must be defined as 1 for this function to be available.
+ *
+ * To be called from the idle hook.  Tasks of higher priority preempt the idle
+ * task as usual, but work done in the idle hook delays other tasks sharing the
+ * idle priority until the hook returns.
+ *
+ * @return pdTRUE if a task other than the idle task is ready to run or a
+ * context switch is pending, so the idle hook should return as soon as
+ * possible, otherwise pdFALSE.
+ */
+#if ( ( configUSE_IDLE_HOOK == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+    BaseType_t xTaskIdleShouldYield( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -2179,6 +2332,68 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetTaskHandles( TaskHandle_t * const pxTaskHandleArray, const UBaseType_t uxArraySize );
+ * @endcode
+ *
+ * configUSE_TRACE_FACILITY must be defined as 1 for this function to be
+ * available.
+ *
+ * A lightweight alternative to uxTaskGetSystemState() that only returns the
+ * handle of each task in the Ready, Running, Blocked or Suspended state.  Tasks
+ * that have been deleted are not included, even if their memory has not been
+ * freed yet.  The scheduler is suspended while the lists are walked, no stack
+ * high water marks are calculated.
+ *
+ * @param pxTaskHandleArray A pointer to an array of TaskHandle_t.  The array
+ * must contain at least uxTaskGetNumberOfTasks() entries.
+ *
+ * @param uxArraySize The size of the array pointed to by the pxTaskHandleArray
+ * parameter.
+ *
+ * @return The number of handles written to pxTaskHandleArray.  Zero if the
+ * array was too small.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+    UBaseType_t uxTaskGetTaskHandles( TaskHandle_t * const pxTaskHandleArray,
+                                      const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskGetStateStats( TaskHandle_t xTask, TaskStateStats_t * pxStateStats );
+ * @endcode
+ *
+ * configUSE_TASK_STATE_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * Run time stats only report the time a task spent running.  With
+ * configUSE_TASK_STATE_STATS the kernel also accumulates the time each task
+ * spends Ready but not running, Blocked (split by the type of object the task
+ * is blocked on) and Suspended, and keeps a histogram of the delay between a
+ * task being unblocked or resumed and it starting to run.  The times are
+ * taken from the run time stats clock on every state transition.
+ *
+ * @param xTask The handle of the task to query.  Passing NULL queries the
+ * calling task.
+ *
+ * @param pxStateStats A pointer to the TaskStateStats_t structure that will be
+ * filled with the statistics of the task, including the time spent in the
+ * current state so far.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xTaskGetStateStats xTaskGetStateStats
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TASK_STATE_STATS == 1 )
+    BaseType_t xTaskGetStateStats( TaskHandle_t xTask,
+                                   TaskStateStats_t * pxStateStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2985,6 +3200,54 @@ BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
 #define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) \
     xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskNotifyGiveAndHandoff( TaskHandle_t xTaskToNotify );
+ * BaseType_t xTaskNotifyGiveAndDonate( TaskHandle_t xTaskToNotify );
+ * BaseType_t xTaskGenericNotifyAndHandoff( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t xDonatePriority );
+ * @endcode
+ *
+ * configUSE_TASK_HANDOFF must be defined as 1 for these functions to be
+ * available.
+ *
+ * Directed yield for producer/consumer pipelines.  Gives a notification like
+ * xTaskNotifyGive() and, if the notified task is then ready with a priority
+ * at or above the priority of the calling task, switches to it immediately
+ * without the usual search for the highest priority task.  The calling task
+ * stays ready and is scheduled again as usual.  With configUSE_TASK_TIME_SLICES
+ * the notified task runs on the rest of the calling task's time slice instead
+ * of a fresh one, the calling task starts with a full slice next time.
+ *
+ * xTaskNotifyGiveAndDonate() first raises the priority of the notified task
+ * to the priority of the calling task (if it is lower), so the handoff also
+ * works for a lower priority consumer.  The donated priority is dropped when
+ * the consumer blocks again, or when it gives back its last mutex.  Priority
+ * donation requires configUSE_MUTEXES to be 1.
+ *
+ * Must not be called from an ISR or with the scheduler suspended.
+ *
+ * @param xTaskToNotify The handle of the task to notify and switch to.
+ *
+ * @param uxIndexToNotify The index within the target task's array of
+ * notification values to which the notification is sent.
+ *
+ * @param xDonatePriority pdTRUE to donate the priority of the calling task.
+ *
+ * @return pdTRUE if the notified task runs next, otherwise pdFALSE (the
+ * notification was still given).
+ *
+ * \defgroup xTaskNotifyGiveAndHandoff xTaskNotifyGiveAndHandoff
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskGenericNotifyAndHandoff( TaskHandle_t xTaskToNotify,
+                                         UBaseType_t uxIndexToNotify,
+                                         BaseType_t xDonatePriority ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyGiveAndHandoff( xTaskToNotify ) \
+    xTaskGenericNotifyAndHandoff( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), pdFALSE )
+#define xTaskNotifyGiveAndDonate( xTaskToNotify ) \
+    xTaskGenericNotifyAndHandoff( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), pdTRUE )
+
 /**
  * task. h
  * @code{c}
@@ -3546,6 +3809,42 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Direct handoff of data between tasks, used if configUSE_QUEUE_DIRECT_HANDOFF
+ * or configUSE_CHANNELS is set to 1.  vTaskSetHandoffBuffer() is called by a
+ * task with the scheduler suspended right before it is placed on an event list,
+ * to publish the buffer it wants to receive into (or send from).
+ * pvTaskTakeHandoffBuffer() is called from within a critical section (or with
+ * the scheduler suspended if the event list is not used by ISRs) and returns
+ * the buffer published by the task at the head of pxEventList (or NULL if it
+ * didn't publish one).  The caller must copy the data and then remove the task
+ * from the event list.  xTaskResetHandoffState() is called by the blocked task
+ * from within a critical section after it was unblocked and returns pdTRUE if
+ * the data was copied.
+ */
+void vTaskSetHandoffBuffer( void * pvBuffer ) PRIVILEGED_FUNCTION;
+void * pvTaskTakeHandoffBuffer( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskResetHandoffState( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Records the kernel object the calling task is about to block on, used if
+ * configUSE_TASK_STATE_STATS is set to 1.  Called right before the task is
+ * placed on an event list or waits for a notification on behalf of the
+ * object.  The record is cleared when the task is moved to the Ready state.
+ */
+#if ( configUSE_TASK_STATE_STATS == 1 )
+    void vTaskSetBlockedOn( void * pvObject,
+                            eBlockedOnType eType ) PRIVILEGED_FUNCTION;
+#else
+    #define vTaskSetBlockedOn( pvObject, eType )
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -106,6 +106,11 @@
 #define taskWAITING_NOTIFICATION                  ( ( uint8_t ) 1 )
 #define taskNOTIFICATION_RECEIVED                 ( ( uint8_t ) 2 )
 
+/* Values that can be assigned to the ucHandoffState member of the TCB. */
+#define taskHANDOFF_NONE                          ( ( uint8_t ) 0 ) /* Must be zero as it is the initialised value. */
+#define taskHANDOFF_WAITING                       ( ( uint8_t ) 1 )
+#define taskHANDOFF_COMPLETE                      ( ( uint8_t ) 2 )
+
 /*
  * The value used to fill the stack of a task when the task is created.  This
  * is used purely for checking the high water mark for tasks.
@@ -117,6 +122,14 @@
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY        ( ( uint8_t ) 1 )
 #define tskSTATICALLY_ALLOCATED_STACK_AND_TCB     ( ( uint8_t ) 2 )
 
+/* The TCB and stack of deleted tasks can only be recycled if both were
+ * allocated by the kernel. */
+#if ( ( configTASK_RECYCLE_CACHE_SIZE > 0 ) && ( INCLUDE_vTaskDelete == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+    #define tskUSE_RECYCLE_CACHE    1
+#else
+    #define tskUSE_RECYCLE_CACHE    0
+#endif
+
 /* If any of the following are set then task stacks are filled with a known
  * value so the high water mark can be determined.  If none of the following are
  * set then don't fill the stack so there is no unnecessary dependency on memset. */
@@ -254,6 +267,27 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_STATE_STATS == 1 )
+
+/* Indices into ulStateTime.  A task in the Blocked state is accounted by the
+ * type of object it is blocked on, a task in the Suspended state is not
+ * blocked on anything. */
+    #define taskSTATE_STATS_RUNNING                 ( ( uint8_t ) 0U )
+    #define taskSTATE_STATS_READY                   ( ( uint8_t ) 1U )
+    #define taskSTATE_STATS_BLOCKED( ucType )       ( ( uint8_t ) ( 2U + ( ucType ) ) )
+    #define taskSTATE_STATS_SUSPENDED               taskSTATE_STATS_BLOCKED( eBlockedOnNothing )
+
+    #define taskSTATE_STATS_MOVED_TO_READY( pxTCB )    prvStateStatsMovedToReady( pxTCB )
+
+/* tskSTATE_STATS_ENTRIES is needed to size StaticTask_t before eBlockedOnType
+ * is defined, so check it matches at compile time.  The array size is
+ * negative if it does not. */
+    typedef char prvStateStatsEntriesCheck_t[ ( tskSTATE_STATS_ENTRIES == ( 2 + eBlockedOnNumTypes ) ) ? 1 : -1 ];
+#else
+    #define taskSTATE_STATS_MOVED_TO_READY( pxTCB )
+#endif
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
@@ -261,6 +295,7 @@
 #define prvAddTaskToReadyList( pxTCB )                                                                     \
     do {                                                                                                   \
         traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+        taskSTATE_STATS_MOVED_TO_READY( pxTCB );                                                           \
         taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
         listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
         tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
@@ -368,7 +403,25 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         volatile BaseType_t xTaskRunState;      /**< Used to identify the core the task is running on, if the task is running. Otherwise, identifies the task's state - not running or yielding. */
         UBaseType_t uxTaskAttributes;           /**< Task's attributes - currently used to identify the idle tasks. */
     #endif
-    char pcTaskName[ configMAX_TASK_NAME_LEN ]; /**< Descriptive name given to the task when created.  Facilitates debugging only. */
+    #if ( configUSE_TASK_TIME_SLICES == 1 )
+        TickType_t xTimeSlice;                  /**< Round robin quantum of the task in ticks, 0 if the task is not time sliced. */
+        TickType_t xTimeSliceLeft;              /**< Ticks left of the current quantum. */
+    #endif
+
+    /* With configUSE_TCB_HOT_COLD_LAYOUT the fields the scheduler touches on
+     * every context switch and tick are grouped above, the remaining (cold)
+     * fields start on a new cache line. */
+    #if ( configUSE_TCB_HOT_COLD_LAYOUT == 1 )
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /**< Stores the amount of time the task has spent in the Running state. */
+        #endif
+
+        #if ( configUSE_POSIX_ERRNO == 1 )
+            int iTaskErrno;
+        #endif
+    #endif /* configUSE_TCB_HOT_COLD_LAYOUT */
+
+    char pcTaskName[ configMAX_TASK_NAME_LEN ] portTCB_COLD_DATA; /**< Descriptive name given to the task when created.  Facilitates debugging only. */
 
     #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
         BaseType_t xPreemptionDisable; /**< Used to prevent the task from being preempted. */
@@ -400,7 +453,7 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         void * pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
     #endif
 
-    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TCB_HOT_COLD_LAYOUT == 0 ) )
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /**< Stores the amount of time the task has spent in the Running state. */
     #endif
 
@@ -423,9 +476,28 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         uint8_t ucDelayAborted;
     #endif
 
-    #if ( configUSE_POSIX_ERRNO == 1 )
+    #if ( ( configUSE_POSIX_ERRNO == 1 ) && ( configUSE_TCB_HOT_COLD_LAYOUT == 0 ) )
         int iTaskErrno;
     #endif
+
+    #if ( configTASK_RECYCLE_CACHE_SIZE > 0 )
+        configSTACK_DEPTH_TYPE uxStackDepth; /**< Size of the stack in words, used to match recycled stacks to new tasks. */
+    #endif
+
+    #if ( tskHANDOFF_BUFFER_POSSIBLE == 1 )
+        void * pvHandoffBuffer;          /**< Buffer published by a blocked receiver, a sender copies its data directly into it. */
+        volatile uint8_t ucHandoffState; /**< One of the taskHANDOFF_ values. */
+    #endif
+
+    #if ( configUSE_TASK_STATE_STATS == 1 )
+        void * pvBlockedOn;                                                /**< Kernel object the task is blocked on, see vTaskSetBlockedOn(). */
+        uint8_t ucBlockedOnType;                                           /**< The eBlockedOnType of pvBlockedOn. */
+        uint8_t ucStatsState;                                              /**< One of the taskSTATE_STATS_ indices, the state the task is accounted in. */
+        uint8_t ucStatsWoken;                                              /**< Set to pdTRUE if the task entered the Ready state from Blocked or Suspended. */
+        configRUN_TIME_COUNTER_TYPE ulStateEntered;                        /**< Run time counter value when the task entered ucStatsState. */
+        configRUN_TIME_COUNTER_TYPE ulStateTime[ tskSTATE_STATS_ENTRIES ]; /**< Time accumulated in each state. */
+        uint32_t ulReadyLatency[ configREADY_LATENCY_BUCKETS ];            /**< Histogram of the delay between unblocking and running. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -463,12 +535,56 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Ta
 
 #endif
 
+#if ( ( configTCB_POOL_SIZE > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+/* TCBs used by dynamically created tasks before the heap is used.  On Teensy 4
+ * .bss is located in DTCM, so these TCBs are not affected by the data cache. */
+    PRIVILEGED_DATA static TCB_t xTCBPool[ configTCB_POOL_SIZE ];
+    PRIVILEGED_DATA static uint8_t ucTCBPoolUsed[ configTCB_POOL_SIZE ];
+
+#endif
+
+#if ( configUSE_TASK_REAPER == 1 )
+
+    PRIVILEGED_DATA static TaskHandle_t xReaperTaskHandle = NULL; /**< Task that frees the memory of tasks that deleted themselves, instead of the idle task. */
+
+#endif
+
+#if ( configUSE_TASK_HANDOFF == 1 )
+
+    PRIVILEGED_DATA static TCB_t * volatile pxHandoffTCB = NULL; /**< Task to switch to on the next context switch, see xTaskGenericNotifyAndHandoff(). */
+
+    #if ( configUSE_TASK_TIME_SLICES == 1 )
+        PRIVILEGED_DATA static TickType_t xHandoffTimeSliceLeft = ( TickType_t ) 0U; /**< Rest of the quantum the calling task donates to the target of a handoff, 0 if none. */
+    #endif
+
+#endif
+
+#if ( tskUSE_RECYCLE_CACHE == 1 )
+
+    PRIVILEGED_DATA static TCB_t * pxRecycledTCBs[ configTASK_RECYCLE_CACHE_SIZE ]; /**< TCBs (with their stacks) of deleted tasks kept for reuse by the next task created with the same stack depth. */
+    PRIVILEGED_DATA static size_t xRecycledBytes = ( size_t ) 0U;                   /**< Memory held by pxRecycledTCBs. */
+
+#endif
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
     PRIVILEGED_DATA static List_t xSuspendedTaskList; /**< Tasks that are currently suspended. */
 
 #endif
 
+#if ( ( INCLUDE_xTaskGetHandle == 1 ) && ( configUSE_TASK_NAME_INDEX == 1 ) )
+
+/* Open addressing (linear probing) hash table mapping task name hashes to
+ * TCBs.  It is updated from within critical sections only.  Readers don't lock
+ * but retry if ulTaskNameIndexSequence changed during the lookup (seqlock). */
+    PRIVILEGED_DATA static TCB_t * volatile pxTaskNameIndex[ configTASK_NAME_INDEX_SIZE ];
+    PRIVILEGED_DATA static uint32_t ulTaskNameIndexHash[ configTASK_NAME_INDEX_SIZE ];
+    PRIVILEGED_DATA static volatile uint32_t ulTaskNameIndexSequence = 0U;
+    PRIVILEGED_DATA static volatile UBaseType_t uxTaskNameIndexOverflow = 0U; /**< Number of tasks that could not be added to the full index, lookup falls back to searching the task lists while non-zero. */
+
+#endif
+
 /* Global POSIX errno. Its value is changed upon context switching to match
  * the errno of the currently running task. */
 #if ( configUSE_POSIX_ERRNO == 1 )
@@ -608,6 +724,58 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Allocate and free the TCB of a dynamically created task.  The TCB is taken
+ * from xTCBPool if configTCB_POOL_SIZE is greater than 0 and a pool entry is
+ * free, else from the heap.  The memory is not initialised.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    static TCB_t * prvAllocateTCB( void ) PRIVILEGED_FUNCTION;
+
+    static void prvFreeTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * The reaper task.  Calls prvCheckTasksWaitingTermination() whenever a task
+ * deleted itself, so the memory is freed even if the idle task does not get
+ * to run.
+ */
+#if ( configUSE_TASK_REAPER == 1 )
+
+    static portTASK_FUNCTION_PROTO( prvReaperTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Makes the task set by xTaskGenericNotifyAndHandoff() the running task if it
+ * is still ready and no task of a higher priority became ready in the
+ * meantime.  Returns pdFALSE if the normal task selection has to be used.
+ */
+#if ( configUSE_TASK_HANDOFF == 1 )
+
+    static BaseType_t prvSelectHandoffTask( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Cache for the TCB and stack of deleted tasks.  prvRecycleCachePut() returns
+ * pdFALSE if the cache is full and the memory must be freed.
+ * prvRecycleCacheTake() returns a zeroed TCB with a stack of usStackDepth
+ * words, or NULL if none is cached.  prvGetTaskHeapBytes() returns the heap
+ * memory held by the TCB and stack of a task.
+ */
+#if ( tskUSE_RECYCLE_CACHE == 1 )
+
+    static BaseType_t prvRecycleCachePut( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static TCB_t * prvRecycleCacheTake( const configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+
+    static size_t prvGetTaskHeapBytes( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * The currently executing task is entering the Blocked state.  Add the task to
  * either the current or the overflow delayed task list.
@@ -615,6 +783,27 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+/*
+ * State accounting of configUSE_TASK_STATE_STATS.  prvStateStatsEnter() adds
+ * the time since the last transition to the state pxTCB was in and moves it to
+ * ucState, prvStateStatsMovedToReady() is called whenever a task is added to a
+ * ready list and prvStateStatsSwitchedOut() when the running task is switched
+ * out.
+ */
+#if ( configUSE_TASK_STATE_STATS == 1 )
+
+    static configRUN_TIME_COUNTER_TYPE prvStateStatsNow( void ) PRIVILEGED_FUNCTION;
+
+    static void prvStateStatsEnter( TCB_t * pxTCB,
+                                    uint8_t ucState,
+                                    configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+    static void prvStateStatsMovedToReady( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static void prvStateStatsSwitchedOut( configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -631,6 +820,17 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Fill an array of TaskHandle_t with the handles of the tasks referenced from
+ * pxList.  Used by uxTaskGetTaskHandles().
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTaskHandlesWithinSingleList( TaskHandle_t * pxTaskHandleArray,
+                                                           List_t * pxList ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Searches pxList for a task with name pcNameToQuery - returning a handle to
  * the task if it is found, or NULL if the task is not found.
@@ -642,6 +842,27 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Maintain the task name index used by xTaskGetHandle().  Insert and remove
+ * must be called from within a critical section.
+ */
+#if ( ( INCLUDE_xTaskGetHandle == 1 ) && ( configUSE_TASK_NAME_INDEX == 1 ) )
+
+    static uint32_t prvTaskNameHash( const char * pcName ) PRIVILEGED_FUNCTION;
+
+    static void prvTaskNameIndexInsert( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static void prvTaskNameIndexRemove( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static TCB_t * prvTaskNameIndexLookup( const char * pcNameToQuery ) PRIVILEGED_FUNCTION;
+
+    #define taskNAME_INDEX_INSERT( pxTCB )    prvTaskNameIndexInsert( pxTCB )
+    #define taskNAME_INDEX_REMOVE( pxTCB )    prvTaskNameIndexRemove( pxTCB )
+#else
+    #define taskNAME_INDEX_INSERT( pxTCB )
+    #define taskNAME_INDEX_REMOVE( pxTCB )
+#endif
+
 /*
  * When a task is created, the stack of the task is filled with a known value.
  * This function determines the 'high water mark' of the task stack by
@@ -674,6 +895,26 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Processes xTicks ticks that occurred while the scheduler was suspended.
+ * Ticks at which no delayed task has to be woken and the tick count does not
+ * wrap are skipped in one step, xTaskIncrementTick() is only called for the
+ * others (and the last one).  The time taken thus depends on the number of
+ * tasks to wake, not on xTicks.  Returns pdTRUE if a context switch is
+ * required.
+ */
+static BaseType_t prvAdvanceTickCount( TickType_t xTicks ) PRIVILEGED_FUNCTION;
+
+#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TASK_TIME_SLICES == 1 ) )
+
+/*
+ * Charges ticks not passed through xTaskIncrementTick() to the time slice of
+ * the running task.  Returns pdTRUE if the quantum expired and another task of
+ * the same priority is ready.
+ */
+    static BaseType_t prvChargeTimeSlice( TickType_t xTicks ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -749,6 +990,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                                   void * const pvParameters,
                                   UBaseType_t uxPriority,
                                   TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocate a zeroed TCB and a stack of usStackDepth words from the heap.
+ * Returns NULL if either allocation failed.
+ */
+    static TCB_t * prvAllocateTCBAndStack( const configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
 #endif /* #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
 
 /*
@@ -1499,10 +1746,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
         if( pxTaskDefinition->puxStackBuffer != NULL )
         {
-            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-            /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = prvAllocateTCB();
 
             if( pxNewTCB != NULL )
             {
@@ -1609,12 +1853,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-    static TCB_t * prvCreateTask( TaskFunction_t pxTaskCode,
-                                  const char * const pcName,
-                                  const configSTACK_DEPTH_TYPE usStackDepth,
-                                  void * const pvParameters,
-                                  UBaseType_t uxPriority,
-                                  TaskHandle_t * const pxCreatedTask )
+    static TCB_t * prvAllocateTCBAndStack( const configSTACK_DEPTH_TYPE usStackDepth )
     {
         TCB_t * pxNewTCB;
 
@@ -1626,10 +1865,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* Allocate space for the TCB.  Where the memory comes from depends on
              * the implementation of the port malloc function and whether or not static
              * allocation is being used. */
-            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-            /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = prvAllocateTCB();
 
             if( pxNewTCB != NULL )
             {
@@ -1646,7 +1882,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 if( pxNewTCB->pxStack == NULL )
                 {
                     /* Could not allocate the stack.  Delete the allocated TCB. */
-                    vPortFree( pxNewTCB );
+                    prvFreeTCB( pxNewTCB );
                     pxNewTCB = NULL;
                 }
             }
@@ -1664,10 +1900,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             if( pxStack != NULL )
             {
                 /* Allocate space for the TCB. */
-                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
-                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-                /* coverity[misra_c_2012_rule_11_5_violation] */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+                pxNewTCB = prvAllocateTCB();
 
                 if( pxNewTCB != NULL )
                 {
@@ -1690,6 +1923,40 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         }
         #endif /* portSTACK_GROWTH */
 
+        return pxNewTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvCreateTask( TaskFunction_t pxTaskCode,
+                                  const char * const pcName,
+                                  const configSTACK_DEPTH_TYPE usStackDepth,
+                                  void * const pvParameters,
+                                  UBaseType_t uxPriority,
+                                  TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+
+        #if ( tskUSE_RECYCLE_CACHE == 1 )
+        {
+            /* Reuse the TCB and stack of a deleted task with the same stack
+             * depth, if one is cached, without going through the heap. */
+            pxNewTCB = prvRecycleCacheTake( usStackDepth );
+
+            if( pxNewTCB == NULL )
+            {
+                pxNewTCB = prvAllocateTCBAndStack( usStackDepth );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* tskUSE_RECYCLE_CACHE */
+        {
+            pxNewTCB = prvAllocateTCBAndStack( usStackDepth );
+        }
+        #endif /* tskUSE_RECYCLE_CACHE */
+
         if( pxNewTCB != NULL )
         {
             #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
@@ -1700,6 +1967,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             }
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
+            #if ( configTASK_RECYCLE_CACHE_SIZE > 0 )
+            {
+                pxNewTCB->uxStackDepth = usStackDepth;
+            }
+            #endif
+
             prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
         }
 
@@ -1813,7 +2086,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
     {
         /* Fill the stack with a known value to assist debugging. */
-        ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
+        ( void ) portMEMSET( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
     }
     #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
 
@@ -1899,6 +2172,22 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* configUSE_MUTEXES */
 
+    #if ( configUSE_TASK_TIME_SLICES == 1 )
+    {
+        pxNewTCB->xTimeSlice = configTASK_TIME_SLICE_TICKS;
+        pxNewTCB->xTimeSliceLeft = configTASK_TIME_SLICE_TICKS;
+    }
+    #endif
+
+    #if ( configUSE_TASK_STATE_STATS == 1 )
+    {
+        /* Accounted as ready from creation on, a new task does not count
+         * towards the ready latency. */
+        pxNewTCB->ucStatsState = taskSTATE_STATS_READY;
+        pxNewTCB->ulStateEntered = prvStateStatsNow();
+    }
+    #endif
+
     vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
     vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -2066,6 +2355,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             #endif /* configUSE_TRACE_FACILITY */
             traceTASK_CREATE( pxNewTCB );
 
+            taskNAME_INDEX_INSERT( pxNewTCB );
+
             prvAddTaskToReadyList( pxNewTCB );
 
             portSETUP_TCB( pxNewTCB );
@@ -2143,6 +2434,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             #endif /* configUSE_TRACE_FACILITY */
             traceTASK_CREATE( pxNewTCB );
 
+            taskNAME_INDEX_INSERT( pxNewTCB );
+
             prvAddTaskToReadyList( pxNewTCB );
 
             portSETUP_TCB( pxNewTCB );
@@ -2232,6 +2525,22 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            /* A deleted task can't be found by its name anymore. */
+            taskNAME_INDEX_REMOVE( pxTCB );
+
+            #if ( configUSE_TASK_HANDOFF == 1 )
+            {
+                if( pxHandoffTCB == pxTCB )
+                {
+                    pxHandoffTCB = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -2256,6 +2565,22 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                  * check the xTasksWaitingTermination list. */
                 ++uxDeletedTasksWaitingCleanUp;
 
+                #if ( configUSE_TASK_REAPER == 1 )
+                {
+                    /* Wake the reaper instead of waiting for the idle task.  The
+                     * resulting context switch is held off until the critical
+                     * section is left, after which this task never runs again. */
+                    if( xReaperTaskHandle != NULL )
+                    {
+                        ( void ) xTaskNotifyGive( xReaperTaskHandle );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_TASK_REAPER */
+
                 /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
                  * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
                 traceTASK_DELETE( pxTCB );
@@ -2973,6 +3298,47 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_TIME_SLICES == 1 )
+
+    void vTaskSetTimeSlice( TaskHandle_t xTask,
+                            TickType_t xTicks )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB );
+
+            pxTCB->xTimeSlice = xTicks;
+
+            /* The new quantum starts with the next tick, it is not added to
+             * what is left of the current one. */
+            pxTCB->xTimeSliceLeft = xTicks;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xTaskGetTimeSlice( TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        TickType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB );
+            xReturn = pxTCB->xTimeSlice;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_TIME_SLICES */
+/*-----------------------------------------------------------*/
+
 #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
     void vTaskCoreAffinitySet( const TaskHandle_t xTask,
                                UBaseType_t uxCoreAffinityMask )
@@ -3162,6 +3528,19 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
             vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
 
+            #if ( configUSE_TASK_STATE_STATS == 1 )
+            {
+                /* The running task is accounted when it is switched out. */
+                pxTCB->pvBlockedOn = NULL;
+                pxTCB->ucBlockedOnType = ( uint8_t ) eBlockedOnNothing;
+
+                if( pxTCB != pxCurrentTCB )
+                {
+                    prvStateStatsEnter( pxTCB, taskSTATE_STATS_SUSPENDED, prvStateStatsNow() );
+                }
+            }
+            #endif
+
             #if ( configUSE_TASK_NOTIFICATIONS == 1 )
             {
                 BaseType_t x;
@@ -3670,6 +4049,19 @@ void vTaskStartScheduler( void )
 
     xReturn = prvCreateIdleTasks();
 
+    #if ( configUSE_TASK_REAPER == 1 )
+    {
+        if( xReturn == pdPASS )
+        {
+            xReturn = xTaskCreate( prvReaperTask, "REAPER", configTASK_REAPER_STACK_DEPTH, NULL, configTASK_REAPER_PRIORITY | portPRIVILEGE_BIT, &xReaperTaskHandle );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_TASK_REAPER */
+
     #if ( configUSE_TIMERS == 1 )
     {
         if( xReturn == pdPASS )
@@ -3723,6 +4115,12 @@ void vTaskStartScheduler( void )
 
         traceTASK_SWITCHED_IN();
 
+        #if ( configUSE_TASK_STATE_STATS == 1 )
+        {
+            prvStateStatsEnter( pxCurrentTCB, taskSTATE_STATS_RUNNING, prvStateStatsNow() );
+        }
+        #endif
+
         /* Setting up the timer tick is hardware specific and thus in the
          * portable interface. */
 
@@ -3875,6 +4273,18 @@ void vTaskSuspendAll( void )
                 uxHigherPriorityReadyTasks = pdTRUE;
             }
         }
+        #elif ( configMAX_PRIORITIES > 32 )
+        {
+            UBaseType_t uxTopPriority;
+
+            /* The idle task is ready, so the bit map is not empty. */
+            portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+
+            if( uxTopPriority > tskIDLE_PRIORITY )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
         #else
         {
             const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
@@ -4013,21 +4423,16 @@ BaseType_t xTaskResumeAll( void )
 
                         if( xPendedCounts > ( TickType_t ) 0U )
                         {
-                            do
+                            if( prvAdvanceTickCount( xPendedCounts ) != pdFALSE )
                             {
-                                if( xTaskIncrementTick() != pdFALSE )
-                                {
-                                    /* Other cores are interrupted from
-                                     * within xTaskIncrementTick(). */
-                                    xYieldPendings[ xCoreID ] = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
-
-                                --xPendedCounts;
-                            } while( xPendedCounts > ( TickType_t ) 0U );
+                                /* Other cores are interrupted from
+                                 * within xTaskIncrementTick(). */
+                                xYieldPendings[ xCoreID ] = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
 
                             xPendedTicks = 0;
                         }
@@ -4137,9 +4542,81 @@ UBaseType_t uxTaskGetNumberOfTasks( void )
 }
 /*-----------------------------------------------------------*/
 
-char * pcTaskGetName( TaskHandle_t xTaskToQuery )
-{
-    TCB_t * pxTCB;
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    UBaseType_t uxTaskGetNumberOfTasksPendingTermination( void )
+    {
+        /* A critical section is not required because the variable is of type
+         * BaseType_t. */
+        return uxDeletedTasksWaitingCleanUp;
+    }
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( tskUSE_RECYCLE_CACHE == 1 )
+
+    size_t xTaskGetRecycleCacheBytes( void )
+    {
+        size_t xReturn;
+        const ListItem_t * pxIterator;
+        const ListItem_t * const pxEndMarker = listGET_END_MARKER( &xTasksWaitingTermination );
+
+        taskENTER_CRITICAL();
+        {
+            xReturn = xRecycledBytes;
+
+            /* Deleted tasks not freed yet still hold their TCB and stack. */
+            for( pxIterator = listGET_HEAD_ENTRY( &xTasksWaitingTermination ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                xReturn += prvGetTaskHeapBytes( ( const TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskRecycleCacheFlush( void )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t x;
+
+        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_RECYCLE_CACHE_SIZE; x++ )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxTCB = pxRecycledTCBs[ x ];
+
+                if( pxTCB != NULL )
+                {
+                    pxRecycledTCBs[ x ] = NULL;
+                    xRecycledBytes -= prvGetTaskHeapBytes( pxTCB );
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            /* Free outside of the critical section, the heap has its own
+             * locking. */
+            if( pxTCB != NULL )
+            {
+                vPortFreeStack( pxTCB->pxStack );
+                prvFreeTCB( pxTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* tskUSE_RECYCLE_CACHE */
+/*-----------------------------------------------------------*/
+
+char * pcTaskGetName( TaskHandle_t xTaskToQuery )
+{
+    TCB_t * pxTCB;
 
     traceENTER_pcTaskGetName( xTaskToQuery );
 
@@ -4154,6 +4631,42 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 }
 /*-----------------------------------------------------------*/
 
+void vTaskSetName( TaskHandle_t xTaskToRename,
+                   const char * pcNewName )
+{
+    TCB_t * pxTCB;
+    UBaseType_t x;
+
+    configASSERT( pcNewName );
+
+    taskENTER_CRITICAL();
+    {
+        /* If null is passed in here then the calling task is renamed. */
+        pxTCB = prvGetTCBFromHandle( xTaskToRename );
+        configASSERT( pxTCB );
+
+        taskNAME_INDEX_REMOVE( pxTCB );
+
+        /* Copy the name like prvInitialiseNewTask() does, names longer than
+         * configMAX_TASK_NAME_LEN - 1 are truncated. */
+        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+        {
+            pxTCB->pcTaskName[ x ] = pcNewName[ x ];
+
+            if( pcNewName[ x ] == ( char ) 0x00 )
+            {
+                break;
+            }
+        }
+
+        pxTCB->pcTaskName[ configMAX_TASK_NAME_LEN - 1U ] = '\0';
+
+        taskNAME_INDEX_INSERT( pxTCB );
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetHandle == 1 )
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -4300,6 +4813,158 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 #endif /* INCLUDE_xTaskGetHandle */
 /*-----------------------------------------------------------*/
 
+#if ( ( INCLUDE_xTaskGetHandle == 1 ) && ( configUSE_TASK_NAME_INDEX == 1 ) )
+
+    static uint32_t prvTaskNameHash( const char * pcName )
+    {
+        /* 32 bit FNV-1a hash over at most configMAX_TASK_NAME_LEN characters. */
+        uint32_t ulHash = 2166136261UL;
+        UBaseType_t x;
+
+        for( x = ( UBaseType_t ) 0; ( x < ( UBaseType_t ) configMAX_TASK_NAME_LEN ) && ( pcName[ x ] != ( char ) 0x00 ); x++ )
+        {
+            ulHash ^= ( uint32_t ) ( uint8_t ) pcName[ x ];
+            ulHash *= 16777619UL;
+        }
+
+        return ulHash;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTaskNameIndexInsert( TCB_t * pxTCB )
+    {
+        const uint32_t ulHash = prvTaskNameHash( pxTCB->pcTaskName );
+        UBaseType_t uxSlot = ( UBaseType_t ) ulHash & ( configTASK_NAME_INDEX_SIZE - 1U );
+        UBaseType_t x;
+
+        ulTaskNameIndexSequence++;
+        portMEMORY_BARRIER();
+
+        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NAME_INDEX_SIZE; x++ )
+        {
+            if( pxTaskNameIndex[ uxSlot ] == NULL )
+            {
+                ulTaskNameIndexHash[ uxSlot ] = ulHash;
+                pxTaskNameIndex[ uxSlot ] = pxTCB;
+                break;
+            }
+
+            uxSlot = ( uxSlot + 1U ) & ( configTASK_NAME_INDEX_SIZE - 1U );
+        }
+
+        if( x == ( UBaseType_t ) configTASK_NAME_INDEX_SIZE )
+        {
+            /* The index is full, this task can only be found by searching the
+             * task lists until it is deleted or renamed. */
+            uxTaskNameIndexOverflow++;
+        }
+
+        portMEMORY_BARRIER();
+        ulTaskNameIndexSequence++;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTaskNameIndexRemove( const TCB_t * pxTCB )
+    {
+        UBaseType_t uxSlot = ( UBaseType_t ) prvTaskNameHash( pxTCB->pcTaskName ) & ( configTASK_NAME_INDEX_SIZE - 1U );
+        UBaseType_t uxNext, uxHome, x;
+
+        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NAME_INDEX_SIZE; x++ )
+        {
+            if( ( pxTaskNameIndex[ uxSlot ] == pxTCB ) || ( pxTaskNameIndex[ uxSlot ] == NULL ) )
+            {
+                break;
+            }
+
+            uxSlot = ( uxSlot + 1U ) & ( configTASK_NAME_INDEX_SIZE - 1U );
+        }
+
+        if( ( x == ( UBaseType_t ) configTASK_NAME_INDEX_SIZE ) || ( pxTaskNameIndex[ uxSlot ] == NULL ) )
+        {
+            /* Not in the index, task was added while the index was full. */
+            configASSERT( uxTaskNameIndexOverflow > 0U );
+            uxTaskNameIndexOverflow--;
+            return;
+        }
+
+        ulTaskNameIndexSequence++;
+        portMEMORY_BARRIER();
+
+        /* Backward shift deletion: move following entries of the probe
+         * sequence into the gap, so no tombstones are needed. */
+        pxTaskNameIndex[ uxSlot ] = NULL;
+        uxNext = ( uxSlot + 1U ) & ( configTASK_NAME_INDEX_SIZE - 1U );
+
+        while( pxTaskNameIndex[ uxNext ] != NULL )
+        {
+            uxHome = ( UBaseType_t ) ulTaskNameIndexHash[ uxNext ] & ( configTASK_NAME_INDEX_SIZE - 1U );
+
+            /* Move the entry if its home slot is not cyclically within
+             * ( uxSlot, uxNext ]. */
+            if( ( ( uxNext - uxHome ) & ( configTASK_NAME_INDEX_SIZE - 1U ) ) >= ( ( uxNext - uxSlot ) & ( configTASK_NAME_INDEX_SIZE - 1U ) ) )
+            {
+                ulTaskNameIndexHash[ uxSlot ] = ulTaskNameIndexHash[ uxNext ];
+                pxTaskNameIndex[ uxSlot ] = pxTaskNameIndex[ uxNext ];
+                pxTaskNameIndex[ uxNext ] = NULL;
+                uxSlot = uxNext;
+            }
+
+            uxNext = ( uxNext + 1U ) & ( configTASK_NAME_INDEX_SIZE - 1U );
+        }
+
+        portMEMORY_BARRIER();
+        ulTaskNameIndexSequence++;
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvTaskNameIndexLookup( const char * pcNameToQuery )
+    {
+        const uint32_t ulHash = prvTaskNameHash( pcNameToQuery );
+        TCB_t * pxReturn;
+        TCB_t * pxTCB;
+        uint32_t ulSequence;
+        UBaseType_t uxSlot, x;
+
+        do
+        {
+            /* An odd sequence number means an update is in progress. */
+            do
+            {
+                ulSequence = ulTaskNameIndexSequence;
+            } while( ( ulSequence & 1U ) != 0U );
+
+            portMEMORY_BARRIER();
+
+            pxReturn = NULL;
+            uxSlot = ( UBaseType_t ) ulHash & ( configTASK_NAME_INDEX_SIZE - 1U );
+
+            for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NAME_INDEX_SIZE; x++ )
+            {
+                pxTCB = pxTaskNameIndex[ uxSlot ];
+
+                if( pxTCB == NULL )
+                {
+                    break;
+                }
+
+                if( ( ulTaskNameIndexHash[ uxSlot ] == ulHash ) && ( strncmp( pxTCB->pcTaskName, pcNameToQuery, configMAX_TASK_NAME_LEN ) == 0 ) )
+                {
+                    pxReturn = pxTCB;
+                    break;
+                }
+
+                uxSlot = ( uxSlot + 1U ) & ( configTASK_NAME_INDEX_SIZE - 1U );
+            }
+
+            portMEMORY_BARRIER();
+        } while( ulSequence != ulTaskNameIndexSequence );
+
+        return pxReturn;
+    }
+
+#endif /* ( ( INCLUDE_xTaskGetHandle == 1 ) && ( configUSE_TASK_NAME_INDEX == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetHandle == 1 )
 
     TaskHandle_t xTaskGetHandle( const char * pcNameToQuery )
@@ -4312,6 +4977,21 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
         /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
         configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
 
+        #if ( configUSE_TASK_NAME_INDEX == 1 )
+        {
+            pxTCB = prvTaskNameIndexLookup( pcNameToQuery );
+
+            /* The task lists only have to be searched if some tasks didn't fit
+             * into the index. */
+            if( ( pxTCB != NULL ) || ( uxTaskNameIndexOverflow == 0U ) )
+            {
+                traceRETURN_xTaskGetHandle( pxTCB );
+
+                return pxTCB;
+            }
+        }
+        #endif /* configUSE_TASK_NAME_INDEX */
+
         vTaskSuspendAll();
         {
             /* Search the ready lists. */
@@ -4501,6 +5181,47 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetTaskHandles( TaskHandle_t * const pxTaskHandleArray,
+                                      const UBaseType_t uxArraySize )
+    {
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+
+        vTaskSuspendAll();
+        {
+            /* uxCurrentNumberOfTasks may still include tasks waiting for
+             * termination, so the check is conservative. */
+            if( uxArraySize >= uxCurrentNumberOfTasks )
+            {
+                do
+                {
+                    uxQueue--;
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTaskHandlesWithinSingleList( &( pxTaskHandleArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ) ) );
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY );
+
+                uxTask = ( UBaseType_t ) ( uxTask + prvListTaskHandlesWithinSingleList( &( pxTaskHandleArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList ) );
+                uxTask = ( UBaseType_t ) ( uxTask + prvListTaskHandlesWithinSingleList( &( pxTaskHandleArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList ) );
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTaskHandlesWithinSingleList( &( pxTaskHandleArray[ uxTask ] ), &xSuspendedTaskList ) );
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -4537,6 +5258,33 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
 
+#if ( ( configUSE_IDLE_HOOK == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+
+    BaseType_t xTaskIdleShouldYield( void )
+    {
+        BaseType_t xReturn;
+
+        /* A critical region is not required here as we are just reading, an
+         * occasional incorrect value only delays the yield to the next call.
+         * Tasks of higher priority than the idle task preempt it anyway unless
+         * they were made ready while the scheduler was suspended, in which case
+         * the yield is pending. */
+        if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES ) ||
+            ( xYieldPendings[ 0 ] != pdFALSE ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ( configUSE_IDLE_HOOK == 1 ) && ( configNUMBER_OF_CORES == 1 ) ) */
+/*----------------------------------------------------------*/
+
 /* This conditional compilation should use inequality to 0, not equality to 1.
  * This is to ensure vTaskStepTick() is available when user defined low power mode
  * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
@@ -4585,6 +5333,110 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 #endif /* configUSE_TICKLESS_IDLE */
 /*----------------------------------------------------------*/
 
+#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TASK_TIME_SLICES == 1 ) )
+
+    static BaseType_t prvChargeTimeSlice( TickType_t xTicks )
+    {
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        /* Charge ticks to the quantum of the running task as the same number
+         * of calls to xTaskIncrementTick() would.  At least one tick is left,
+         * so the next xTaskIncrementTick() handles the expiry. */
+        if( ( xTicks > ( TickType_t ) 0U ) && ( pxCurrentTCB->xTimeSlice != ( TickType_t ) 0U ) )
+        {
+            if( xTicks < pxCurrentTCB->xTimeSliceLeft )
+            {
+                pxCurrentTCB->xTimeSliceLeft -= xTicks;
+            }
+            else
+            {
+                /* The quantum expired within the ticks, a new one started. */
+                pxCurrentTCB->xTimeSliceLeft = pxCurrentTCB->xTimeSlice - ( ( xTicks - pxCurrentTCB->xTimeSliceLeft ) % pxCurrentTCB->xTimeSlice );
+
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xSwitchRequired;
+    }
+
+#endif /* #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TASK_TIME_SLICES == 1 ) ) */
+/*----------------------------------------------------------*/
+
+static BaseType_t prvAdvanceTickCount( TickType_t xTicks )
+{
+    TickType_t xTicksToNextEvent;
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    /* Called from a critical section with the scheduler no longer suspended,
+     * so xTaskIncrementTick() moves the tick count. */
+    while( xTicks > ( TickType_t ) 0U )
+    {
+        /* xNextTaskUnblockTime is never later than the wake time of the first
+         * delayed task, and it is at most portMAX_DELAY, so the tick count can
+         * not wrap before it is reached. */
+        if( xNextTaskUnblockTime > xTickCount )
+        {
+            xTicksToNextEvent = xNextTaskUnblockTime - xTickCount;
+
+            if( xTicksToNextEvent > xTicks )
+            {
+                xTicksToNextEvent = xTicks;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xTicksToNextEvent = ( TickType_t ) 1U;
+        }
+
+        /* No task is unblocked in the skipped ticks.  The last tick unblocks
+         * the tasks and switches the delayed lists. */
+        xTickCount += xTicksToNextEvent - ( TickType_t ) 1U;
+
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TASK_TIME_SLICES == 1 ) )
+        {
+            if( prvChargeTimeSlice( xTicksToNextEvent - ( TickType_t ) 1U ) != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        if( xTaskIncrementTick() != pdFALSE )
+        {
+            xSwitchRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xTicks -= xTicksToNextEvent;
+    }
+
+    return xSwitchRequired;
+}
+/*----------------------------------------------------------*/
+
 BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 {
     BaseType_t xYieldOccurred;
@@ -4849,7 +5701,36 @@ BaseType_t xTaskIncrementTick( void )
         /* Tasks of equal priority to the currently running task will share
          * processing time (time slice) if preemption is on, and the application
          * writer has not explicitly turned time slicing off. */
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TASK_TIME_SLICES == 1 ) )
+        {
+            /* Only the running task consumes its quantum.  When it is used
+             * up, the next task of the same priority runs. */
+            if( pxCurrentTCB->xTimeSlice != ( TickType_t ) 0U )
+            {
+                if( pxCurrentTCB->xTimeSliceLeft > ( TickType_t ) 1U )
+                {
+                    pxCurrentTCB->xTimeSliceLeft--;
+                }
+                else
+                {
+                    pxCurrentTCB->xTimeSliceLeft = pxCurrentTCB->xTimeSlice;
+
+                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #elif ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
             #if ( configNUMBER_OF_CORES == 1 )
             {
@@ -4880,7 +5761,7 @@ BaseType_t xTaskIncrementTick( void )
             }
             #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
         }
-        #endif /* #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+        #endif /* #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TASK_TIME_SLICES == 1 ) ) */
 
         #if ( configUSE_TICK_HOOK == 1 )
         {
@@ -5074,21 +5955,96 @@ BaseType_t xTaskIncrementTick( void )
             xTCB = xTask;
         }
 
-        if( xTCB->pxTaskTag != NULL )
-        {
-            xReturn = xTCB->pxTaskTag( pvParameter );
+        if( xTCB->pxTaskTag != NULL )
+        {
+            xReturn = xTCB->pxTaskTag( pvParameter );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        traceRETURN_xTaskCallApplicationTaskHook( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_HANDOFF == 1 )
+
+    static BaseType_t prvSelectHandoffTask( void )
+    {
+        TCB_t * const pxTCB = pxHandoffTCB;
+        UBaseType_t uxTopPriority;
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxTCB != NULL )
+        {
+            pxHandoffTCB = NULL;
+
+            #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+            {
+                /* uxTopReadyPriority is an upper bound of the highest
+                 * priority with ready tasks. */
+                uxTopPriority = uxTopReadyPriority;
+            }
+            #else
+            {
+                portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+            }
+            #endif
+
+            /* An interrupt may have readied a higher priority task or
+             * blocked the target since the handoff was requested. */
+            if( ( pxTCB->uxPriority >= uxTopPriority ) &&
+                ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                /* Continue the round robin of the priority from the target,
+                 * as if taskSELECT_HIGHEST_PRIORITY_TASK() selected it. */
+                pxReadyTasksLists[ pxTCB->uxPriority ].pxIndex = &( pxTCB->xStateListItem );
+
+                #if ( configUSE_TASK_TIME_SLICES == 1 )
+                {
+                    /* The target runs on the rest of the caller's quantum,
+                     * the caller starts with a full one next time. */
+                    if( pxCurrentTCB->xTimeSlice != ( TickType_t ) 0U )
+                    {
+                        xHandoffTimeSliceLeft = pxCurrentTCB->xTimeSliceLeft;
+                        pxCurrentTCB->xTimeSliceLeft = pxCurrentTCB->xTimeSlice;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+
+                pxCurrentTCB = pxTCB;
+
+                #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+                {
+                    uxTopReadyPriority = pxTCB->uxPriority;
+                }
+                #endif
+
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
-            xReturn = pdFAIL;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_xTaskCallApplicationTaskHook( xReturn );
-
         return xReturn;
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* configUSE_TASK_HANDOFF */
 /*-----------------------------------------------------------*/
 
 #if ( configNUMBER_OF_CORES == 1 )
@@ -5135,6 +6091,12 @@ BaseType_t xTaskIncrementTick( void )
             }
             #endif /* configGENERATE_RUN_TIME_STATS */
 
+            #if ( configUSE_TASK_STATE_STATS == 1 )
+            {
+                prvStateStatsSwitchedOut( ulTotalRunTime[ 0 ] );
+            }
+            #endif
+
             /* Check for stack overflow, if configured. */
             taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -5146,13 +6108,50 @@ BaseType_t xTaskIncrementTick( void )
             #endif
 
             /* Select a new task to run using either the generic C or port
-             * optimised asm code. */
-            /* MISRA Ref 11.5.3 [Void pointer assignment] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-            /* coverity[misra_c_2012_rule_11_5_violation] */
-            taskSELECT_HIGHEST_PRIORITY_TASK();
+             * optimised asm code, unless the previous task handed off to a
+             * specific task. */
+            #if ( configUSE_TASK_HANDOFF == 1 )
+                if( prvSelectHandoffTask() == pdFALSE )
+            #endif
+            {
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                taskSELECT_HIGHEST_PRIORITY_TASK();
+            }
             traceTASK_SWITCHED_IN();
 
+            #if ( configUSE_TASK_STATE_STATS == 1 )
+            {
+                prvStateStatsEnter( pxCurrentTCB, taskSTATE_STATS_RUNNING, ulTotalRunTime[ 0 ] );
+            }
+            #endif
+
+            #if ( ( configUSE_TASK_TIME_SLICES == 1 ) && ( configTASK_TIME_SLICE_CARRY_OVER == 0 ) )
+            {
+                /* Without carry-over a task starts with a full quantum each
+                 * time it is switched in, otherwise it continues with what
+                 * was left when it was preempted or blocked. */
+                pxCurrentTCB->xTimeSliceLeft = pxCurrentTCB->xTimeSlice;
+            }
+            #endif
+
+            #if ( ( configUSE_TASK_HANDOFF == 1 ) && ( configUSE_TASK_TIME_SLICES == 1 ) )
+            {
+                if( xHandoffTimeSliceLeft != ( TickType_t ) 0U )
+                {
+                    /* The target of a handoff takes over the quantum of the
+                     * calling task instead of getting a fresh one. */
+                    pxCurrentTCB->xTimeSliceLeft = xHandoffTimeSliceLeft;
+                    xHandoffTimeSliceLeft = ( TickType_t ) 0U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             /* Macro to inject port specific behaviour immediately after
              * switching tasks, such as setting an end of stack watchpoint
              * or reconfiguring the MPU. */
@@ -5808,8 +6807,13 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
     for( ; configCONTROL_INFINITE_LOOP(); )
     {
         /* See if any tasks have deleted themselves - if so then the idle task
-         * is responsible for freeing the deleted task's TCB and stack. */
-        prvCheckTasksWaitingTermination();
+         * is responsible for freeing the deleted task's TCB and stack, unless
+         * the reaper task does it. */
+        #if ( configUSE_TASK_REAPER == 0 )
+        {
+            prvCheckTasksWaitingTermination();
+        }
+        #endif
 
         #if ( configUSE_PREEMPTION == 0 )
         {
@@ -5918,6 +6922,26 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_REAPER == 1 )
+
+    static portTASK_FUNCTION( prvReaperTask, pvParameters )
+    {
+        /* Stop warnings. */
+        ( void ) pvParameters;
+
+        for( ; configCONTROL_INFINITE_LOOP(); )
+        {
+            /* Also collects tasks that were deleted before the scheduler was
+             * started, these did not notify the reaper. */
+            prvCheckTasksWaitingTermination();
+
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        }
+    }
+
+#endif /* configUSE_TASK_REAPER */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TICKLESS_IDLE != 0 )
 
     eSleepModeStatus eTaskConfirmSleepModeStatus( void )
@@ -6081,7 +7105,7 @@ static void prvInitialiseTaskLists( void )
 
 static void prvCheckTasksWaitingTermination( void )
 {
-    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK OR THE REAPER TASK **/
 
     #if ( INCLUDE_vTaskDelete == 1 )
     {
@@ -6340,6 +7364,32 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTaskHandlesWithinSingleList( TaskHandle_t * pxTaskHandleArray,
+                                                           List_t * pxList )
+    {
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator;
+        UBaseType_t uxTask = 0;
+
+        /* Walk the list directly rather than with listGET_OWNER_OF_NEXT_ENTRY(),
+         * which would move the round robin index of the ready lists. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTaskHandleArray[ uxTask ] = ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxIterator );
+            uxTask++;
+        }
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
     static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
@@ -6406,89 +7456,284 @@ static void prvCheckTasksWaitingTermination( void )
 
 #if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
 
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxTaskGetStackHighWaterMark( xTask );
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+        }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    static void prvDeleteTCB( TCB_t * pxTCB )
+    {
+        /* This call is required specifically for the TriCore port.  It must be
+         * above the vPortFree() calls.  The call is also used by ports/demos that
+         * want to allocate and clean RAM statically. */
+        portCLEAN_UP_TCB( pxTCB );
+
+        #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
+        {
+            /* Free up the memory allocated for the task's TLS Block. */
+            configDEINIT_TLS_BLOCK( pxTCB->xTLSBlock );
+        }
+        #endif
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        {
+            /* The task can only have been allocated dynamically - free both
+             * the stack and TCB, unless they are kept for reuse. */
+            #if ( tskUSE_RECYCLE_CACHE == 1 )
+            {
+                if( prvRecycleCachePut( pxTCB ) == pdFALSE )
+                {
+                    vPortFreeStack( pxTCB->pxStack );
+                    prvFreeTCB( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* tskUSE_RECYCLE_CACHE */
+            {
+                vPortFreeStack( pxTCB->pxStack );
+                prvFreeTCB( pxTCB );
+            }
+            #endif /* tskUSE_RECYCLE_CACHE */
+        }
+        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+        {
+            /* The task could have been allocated statically or dynamically, so
+             * check what was statically allocated before trying to free the
+             * memory. */
+            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            {
+                /* Both the stack and TCB were allocated dynamically, so both
+                 * must be freed, unless they are kept for reuse. */
+                #if ( tskUSE_RECYCLE_CACHE == 1 )
+                {
+                    if( prvRecycleCachePut( pxTCB ) == pdFALSE )
+                    {
+                        vPortFreeStack( pxTCB->pxStack );
+                        prvFreeTCB( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* tskUSE_RECYCLE_CACHE */
+                {
+                    vPortFreeStack( pxTCB->pxStack );
+                    prvFreeTCB( pxTCB );
+                }
+                #endif /* tskUSE_RECYCLE_CACHE */
+            }
+            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+            {
+                /* Only the stack was statically allocated, so the TCB is the
+                 * only memory that must be freed. */
+                prvFreeTCB( pxTCB );
+            }
+            else
+            {
+                /* Neither the stack nor the TCB were allocated dynamically, so
+                 * nothing needs to be freed. */
+                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    }
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    static TCB_t * prvAllocateTCB( void )
+    {
+        TCB_t * pxTCB = NULL;
+
+        #if ( configTCB_POOL_SIZE > 0 )
+        {
+            UBaseType_t x;
+
+            taskENTER_CRITICAL();
+            {
+                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTCB_POOL_SIZE; x++ )
+                {
+                    if( ucTCBPoolUsed[ x ] == ( uint8_t ) pdFALSE )
+                    {
+                        ucTCBPoolUsed[ x ] = ( uint8_t ) pdTRUE;
+                        pxTCB = &( xTCBPool[ x ] );
+                        break;
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        #endif /* configTCB_POOL_SIZE */
+
+        if( pxTCB == NULL )
+        {
+            #if ( configUSE_TCB_HOT_COLD_LAYOUT == 1 )
+            {
+                /* The hot fields must not share a cache line with unrelated
+                 * heap data. */
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTCB = ( TCB_t * ) pvPortMallocAligned( portCACHE_LINE_SIZE, sizeof( TCB_t ) );
+            }
+            #else
+            {
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            }
+            #endif /* configUSE_TCB_HOT_COLD_LAYOUT */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeTCB( TCB_t * pxTCB )
+    {
+        #if ( configTCB_POOL_SIZE > 0 )
+            if( ( pxTCB >= &( xTCBPool[ 0 ] ) ) && ( pxTCB < &( xTCBPool[ configTCB_POOL_SIZE ] ) ) )
+            {
+                /* A single byte store, no critical section required. */
+                ucTCBPoolUsed[ pxTCB - &( xTCBPool[ 0 ] ) ] = ( uint8_t ) pdFALSE;
+            }
+            else
+        #endif /* configTCB_POOL_SIZE */
+        {
+            vPortFree( pxTCB );
+        }
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( tskUSE_RECYCLE_CACHE == 1 )
+
+    static BaseType_t prvRecycleCachePut( TCB_t * pxTCB )
+    {
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t x;
+
+        taskENTER_CRITICAL();
+        {
+            for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_RECYCLE_CACHE_SIZE; x++ )
+            {
+                if( pxRecycledTCBs[ x ] == NULL )
+                {
+                    pxRecycledTCBs[ x ] = pxTCB;
+                    xRecycledBytes += prvGetTaskHeapBytes( pxTCB );
+                    xReturn = pdTRUE;
+                    break;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvRecycleCacheTake( const configSTACK_DEPTH_TYPE usStackDepth )
     {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
-
-        traceENTER_uxTaskGetStackHighWaterMark( xTask );
+        TCB_t * pxTCB = NULL;
+        StackType_t * pxStack;
+        UBaseType_t x;
 
-        pxTCB = prvGetTCBFromHandle( xTask );
+        taskENTER_CRITICAL();
+        {
+            for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_RECYCLE_CACHE_SIZE; x++ )
+            {
+                if( ( pxRecycledTCBs[ x ] != NULL ) && ( pxRecycledTCBs[ x ]->uxStackDepth == usStackDepth ) )
+                {
+                    pxTCB = pxRecycledTCBs[ x ];
+                    pxRecycledTCBs[ x ] = NULL;
+                    xRecycledBytes -= prvGetTaskHeapBytes( pxTCB );
+                    break;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
 
-        #if portSTACK_GROWTH < 0
+        if( pxTCB != NULL )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            /* Hand out the TCB in the same state as a freshly allocated one. */
+            pxStack = pxTCB->pxStack;
+            ( void ) memset( ( void * ) pxTCB, 0x00, sizeof( TCB_t ) );
+            pxTCB->pxStack = pxStack;
         }
-        #else
+        else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
-
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
-
-        traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
 
-        return uxReturn;
+        return pxTCB;
     }
-
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
-
-    static void prvDeleteTCB( TCB_t * pxTCB )
+    static size_t prvGetTaskHeapBytes( const TCB_t * pxTCB )
     {
-        /* This call is required specifically for the TriCore port.  It must be
-         * above the vPortFree() calls.  The call is also used by ports/demos that
-         * want to allocate and clean RAM statically. */
-        portCLEAN_UP_TCB( pxTCB );
+        size_t xBytes = ( ( size_t ) pxTCB->uxStackDepth * sizeof( StackType_t ) ) + sizeof( TCB_t );
 
-        #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
-        {
-            /* Free up the memory allocated for the task's TLS Block. */
-            configDEINIT_TLS_BLOCK( pxTCB->xTLSBlock );
-        }
-        #endif
-
-        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
         {
-            /* The task can only have been allocated dynamically - free both
-             * the stack and TCB. */
-            vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
-        }
-        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
-        {
-            /* The task could have been allocated statically or dynamically, so
-             * check what was statically allocated before trying to free the
-             * memory. */
-            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
             {
-                /* Both the stack and TCB were allocated dynamically, so both
-                 * must be freed. */
-                vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                xBytes = sizeof( TCB_t );
             }
-            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB )
             {
-                /* Only the stack was statically allocated, so the TCB is the
-                 * only memory that must be freed. */
-                vPortFree( pxTCB );
+                xBytes = ( size_t ) 0U;
             }
             else
             {
-                /* Neither the stack nor the TCB were allocated dynamically, so
-                 * nothing needs to be freed. */
-                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+        return xBytes;
     }
 
-#endif /* INCLUDE_vTaskDelete */
+#endif /* tskUSE_RECYCLE_CACHE */
 /*-----------------------------------------------------------*/
 
 static void prvResetNextTaskUnblockTime( void )
@@ -7600,6 +8845,213 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( tskHANDOFF_BUFFER_POSSIBLE == 1 )
+
+    void vTaskSetHandoffBuffer( void * pvBuffer )
+    {
+        /* The scheduler is suspended, so no other task can access the fields. */
+        configASSERT( uxSchedulerSuspended != ( UBaseType_t ) 0U );
+
+        pxCurrentTCB->pvHandoffBuffer = pvBuffer;
+        pxCurrentTCB->ucHandoffState = taskHANDOFF_WAITING;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvTaskTakeHandoffBuffer( const List_t * const pxEventList )
+    {
+        TCB_t * pxWaitingTCB;
+        void * pvReturn = NULL;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION OR WITH THE
+         * SCHEDULER SUSPENDED IF THE EVENT LIST IS NOT ACCESSED FROM ISRS. */
+
+        if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+        {
+            /* The event list is sorted in priority order, the task at the head
+             * is the one xTaskRemoveFromEventList() will unblock. */
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxWaitingTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
+
+            if( pxWaitingTCB->ucHandoffState == taskHANDOFF_WAITING )
+            {
+                pxWaitingTCB->ucHandoffState = taskHANDOFF_COMPLETE;
+                pvReturn = pxWaitingTCB->pvHandoffBuffer;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskResetHandoffState( void )
+    {
+        BaseType_t xReturn;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION. */
+
+        xReturn = ( pxCurrentTCB->ucHandoffState == taskHANDOFF_COMPLETE ) ? pdTRUE : pdFALSE;
+        pxCurrentTCB->ucHandoffState = taskHANDOFF_NONE;
+        pxCurrentTCB->pvHandoffBuffer = NULL;
+
+        return xReturn;
+    }
+
+#endif /* tskHANDOFF_BUFFER_POSSIBLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_STATE_STATS == 1 )
+
+    static configRUN_TIME_COUNTER_TYPE prvStateStatsNow( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+        #else
+            ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        return ulNow;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStateStatsEnter( TCB_t * pxTCB,
+                                    uint8_t ucState,
+                                    configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        configRUN_TIME_COUNTER_TYPE ulElapsed;
+        UBaseType_t uxBucket = 0U;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION OR FROM THE
+         * CONTEXT SWITCH. */
+
+        /* Same guard against suspect run time counters as for the run time
+         * stats. */
+        ulElapsed = ( ulNow > pxTCB->ulStateEntered ) ? ( ulNow - pxTCB->ulStateEntered ) : ( configRUN_TIME_COUNTER_TYPE ) 0U;
+        pxTCB->ulStateTime[ pxTCB->ucStatsState ] += ulElapsed;
+
+        if( ( ucState == taskSTATE_STATS_RUNNING ) && ( pxTCB->ucStatsState == taskSTATE_STATS_READY ) && ( pxTCB->ucStatsWoken != ( uint8_t ) pdFALSE ) )
+        {
+            while( ( ulElapsed != ( configRUN_TIME_COUNTER_TYPE ) 0U ) && ( uxBucket < ( UBaseType_t ) ( configREADY_LATENCY_BUCKETS - 1 ) ) )
+            {
+                ulElapsed >>= 1U;
+                uxBucket++;
+            }
+
+            pxTCB->ulReadyLatency[ uxBucket ]++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->ucStatsWoken = ( uint8_t ) pdFALSE;
+        pxTCB->ucStatsState = ucState;
+        pxTCB->ulStateEntered = ulNow;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStateStatsMovedToReady( TCB_t * pxTCB )
+    {
+        pxTCB->pvBlockedOn = NULL;
+        pxTCB->ucBlockedOnType = ( uint8_t ) eBlockedOnNothing;
+
+        /* Tasks moved between ready lists on a priority change stay in their
+         * state, as does the running task if it was unblocked before it was
+         * switched out. */
+        if( ( pxTCB->ucStatsState != taskSTATE_STATS_RUNNING ) && ( pxTCB->ucStatsState != taskSTATE_STATS_READY ) )
+        {
+            prvStateStatsEnter( pxTCB, taskSTATE_STATS_READY, prvStateStatsNow() );
+            pxTCB->ucStatsWoken = ( uint8_t ) pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStateStatsSwitchedOut( configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        uint8_t ucState;
+
+        /* A task still in its ready list was preempted or yielded, otherwise
+         * it blocked or suspended itself. */
+        if( listLIST_ITEM_CONTAINER( &( pxCurrentTCB->xStateListItem ) ) == &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) )
+        {
+            ucState = taskSTATE_STATS_READY;
+        }
+        else
+        {
+            ucState = taskSTATE_STATS_BLOCKED( pxCurrentTCB->ucBlockedOnType );
+        }
+
+        prvStateStatsEnter( pxCurrentTCB, ucState, ulNow );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskSetBlockedOn( void * pvObject,
+                            eBlockedOnType eType )
+    {
+        pxCurrentTCB->pvBlockedOn = pvObject;
+        pxCurrentTCB->ucBlockedOnType = ( uint8_t ) eType;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskGetStateStats( TaskHandle_t xTask,
+                                   TaskStateStats_t * pxStateStats )
+    {
+        TCB_t * pxTCB;
+        configRUN_TIME_COUNTER_TYPE ulStateTime[ tskSTATE_STATS_ENTRIES ];
+        configRUN_TIME_COUNTER_TYPE ulNow;
+        UBaseType_t x;
+
+        configASSERT( pxStateStats != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            ulNow = prvStateStatsNow();
+
+            ( void ) memcpy( ( void * ) ulStateTime, ( void * ) pxTCB->ulStateTime, sizeof( ulStateTime ) );
+            ( void ) memcpy( ( void * ) pxStateStats->ulReadyLatency, ( void * ) pxTCB->ulReadyLatency, sizeof( pxStateStats->ulReadyLatency ) );
+
+            if( ulNow > pxTCB->ulStateEntered )
+            {
+                ulStateTime[ pxTCB->ucStatsState ] += ulNow - pxTCB->ulStateEntered;
+            }
+
+            pxStateStats->pvBlockedOn = pxTCB->pvBlockedOn;
+            pxStateStats->eBlockedOn = ( eBlockedOnType ) pxTCB->ucBlockedOnType;
+        }
+        taskEXIT_CRITICAL();
+
+        pxStateStats->ulRunningTime = ulStateTime[ taskSTATE_STATS_RUNNING ];
+        pxStateStats->ulReadyTime = ulStateTime[ taskSTATE_STATS_READY ];
+        pxStateStats->ulSuspendedTime = ulStateTime[ taskSTATE_STATS_SUSPENDED ];
+        pxStateStats->ulBlockedTime[ eBlockedOnNothing ] = 0U;
+
+        for( x = ( UBaseType_t ) 1U; x < ( UBaseType_t ) eBlockedOnNumTypes; x++ )
+        {
+            pxStateStats->ulBlockedTime[ x ] = ulStateTime[ taskSTATE_STATS_BLOCKED( x ) ];
+        }
+
+        return pdPASS;
+    }
+
+#endif /* configUSE_TASK_STATE_STATS */
+/*-----------------------------------------------------------*/
+
 TickType_t uxTaskResetEventItemValue( void )
 {
     TickType_t uxReturn;
@@ -7706,6 +9158,16 @@ TickType_t uxTaskResetEventItemValue( void )
                 {
                     taskEXIT_CRITICAL();
 
+                    #if ( configUSE_TASK_STATE_STATS == 1 )
+                    {
+                        /* Stream buffers record themselves before waiting. */
+                        if( pxCurrentTCB->ucBlockedOnType == ( uint8_t ) eBlockedOnNothing )
+                        {
+                            vTaskSetBlockedOn( NULL, eBlockedOnNotification );
+                        }
+                    }
+                    #endif
+
                     prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
                 }
                 xAlreadyYielded = xTaskResumeAll();
@@ -7831,6 +9293,16 @@ TickType_t uxTaskResetEventItemValue( void )
                 {
                     taskEXIT_CRITICAL();
 
+                    #if ( configUSE_TASK_STATE_STATS == 1 )
+                    {
+                        /* Stream buffers record themselves before waiting. */
+                        if( pxCurrentTCB->ucBlockedOnType == ( uint8_t ) eBlockedOnNothing )
+                        {
+                            vTaskSetBlockedOn( NULL, eBlockedOnNotification );
+                        }
+                    }
+                    #endif
+
                     prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
                 }
                 xAlreadyYielded = xTaskResumeAll();
@@ -8014,6 +9486,69 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_HANDOFF == 1 )
+
+    BaseType_t xTaskGenericNotifyAndHandoff( TaskHandle_t xTaskToNotify,
+                                             UBaseType_t uxIndexToNotify,
+                                             BaseType_t xDonatePriority )
+    {
+        TCB_t * const pxTCB = xTaskToNotify;
+        BaseType_t xReturn = pdFALSE;
+
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( pxTCB );
+        configASSERT( pxTCB != pxCurrentTCB );
+        configASSERT( uxSchedulerSuspended == ( UBaseType_t ) 0U );
+
+        taskENTER_CRITICAL();
+        {
+            #if ( configUSE_MUTEXES == 1 )
+            {
+                if( xDonatePriority != pdFALSE )
+                {
+                    /* Same as if the target held a mutex the calling task
+                     * waits for.  The priority is restored when the target
+                     * blocks, see prvAddCurrentTaskToDelayedList(). */
+                    ( void ) xTaskPriorityInherit( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else
+            {
+                ( void ) xDonatePriority;
+            }
+            #endif /* configUSE_MUTEXES */
+
+            /* Unblocks the target if it waits for the notification.  A
+             * yield this may pend is taken over by the one below. */
+            ( void ) xTaskGenericNotify( pxTCB, uxIndexToNotify, 0U, eIncrement, NULL );
+
+            if( ( pxTCB->uxPriority >= pxCurrentTCB->uxPriority ) &&
+                ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                /* Switch directly to the target, even if other tasks of the
+                 * same priority are ready.  The calling task donates the
+                 * rest of its time slice to the target. */
+                pxHandoffTCB = pxTCB;
+                portYIELD_WITHIN_API();
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_HANDOFF */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
@@ -8490,6 +10025,16 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     }
     #endif
 
+    #if ( configUSE_TASK_STATE_STATS == 1 )
+    {
+        /* A task that did not record an object blocks on time only. */
+        if( pxCurrentTCB->ucBlockedOnType == ( uint8_t ) eBlockedOnNothing )
+        {
+            pxCurrentTCB->ucBlockedOnType = ( uint8_t ) eBlockedOnDelay;
+        }
+    }
+    #endif
+
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -8503,6 +10048,34 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         mtCOVERAGE_TEST_MARKER();
     }
 
+    #if ( ( configUSE_TASK_HANDOFF == 1 ) && ( configUSE_MUTEXES == 1 ) )
+    {
+        /* A raised priority without a mutex held was donated by
+         * xTaskGenericNotifyAndHandoff().  The donation ends when the task
+         * blocks again.  The position in an event list the task was just
+         * added to is kept. */
+        if( ( pxCurrentTCB->uxMutexesHeld == ( UBaseType_t ) 0U ) && ( pxCurrentTCB->uxPriority != pxCurrentTCB->uxBasePriority ) )
+        {
+            traceTASK_PRIORITY_DISINHERIT( pxCurrentTCB, pxCurrentTCB->uxBasePriority );
+            pxCurrentTCB->uxPriority = pxCurrentTCB->uxBasePriority;
+
+            if( ( listLIST_ITEM_CONTAINER( &( pxCurrentTCB->xEventListItem ) ) == NULL ) &&
+                ( ( listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0UL ) ) )
+            {
+                listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( ( configUSE_TASK_HANDOFF == 1 ) && ( configUSE_MUTEXES == 1 ) ) */
+
     #if ( INCLUDE_vTaskSuspend == 1 )
     {
         if( ( xTicksToWait == portMAX_DELAY ) && ( xCanBlockIndefinitely != pdFALSE ) )
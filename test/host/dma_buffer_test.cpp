@@ -0,0 +1,122 @@
+/*
+ * This file is part of the FreeRTOS port to Teensy boards.
+ * Copyright (c) 2026 Timo Sandmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file    dma_buffer_test.cpp
+ * @brief   Host test of the DMA buffer allocator
+ * @author  Timo Sandmann
+ * @date    18.10.2026
+ */
+
+/* built and run by run_tests.sh in the repository root */
+
+#include "dma_buffer.h"
+
+#include <cstdint>
+#include <cstdio>
+
+
+/* independent of NDEBUG, counts the failed checks */
+#define CHECK(expr) check((expr), #expr, __LINE__)
+
+using namespace freertos;
+
+namespace {
+int g_failures;
+
+void check(const bool ok, const char* expr, const int line) {
+    if (!ok) {
+        std::printf("%s:%d: check failed: %s\n", __FILE__, line, expr);
+        ++g_failures;
+    }
+}
+
+bool line_aligned(const void* ptr) {
+    return (reinterpret_cast<uintptr_t>(ptr) & (DMA_CACHE_LINE_SIZE - 1)) == 0;
+}
+
+void test_sizes() {
+    CHECK(!dma_alloc(0));
+    CHECK(!dma_alloc(DMA_PAGE_SIZE + 1));
+
+    for (size_t size { 1 }; size <= DMA_PAGE_SIZE; size = size * 3 + 1) {
+        void* const ptr { dma_alloc(size) };
+        CHECK(ptr && line_aligned(ptr));
+        const size_t padded { dma_buffer_size(ptr) };
+        CHECK(padded >= size && padded >= DMA_CACHE_LINE_SIZE && (padded & (padded - 1)) == 0);
+        dma_free(ptr);
+    }
+
+    int local;
+    CHECK(dma_buffer_size(&local) == 0);
+}
+
+void test_reuse() {
+    void* const first { dma_alloc(100, dma_region::dtcm) };
+    dma_free(first);
+    void* const second { dma_alloc(128, dma_region::dtcm) };
+    CHECK(second == first);
+    dma_free(second);
+}
+
+void test_exhaustion() {
+    static void* buffers[DMA_DTCM_POOL_SIZE / DMA_PAGE_SIZE + 1];
+    size_t num {};
+    while (num < sizeof(buffers) / sizeof(buffers[0])) {
+        void* const ptr { dma_alloc(DMA_PAGE_SIZE, dma_region::dtcm) };
+        if (!ptr) {
+            break;
+        }
+        buffers[num++] = ptr;
+    }
+    /* the dtcm pool had a page assigned to the 128 byte class by test_reuse() */
+    CHECK(num == DMA_DTCM_POOL_SIZE / DMA_PAGE_SIZE - 1);
+    for (size_t i {}; i < num; ++i) {
+        dma_free(buffers[i]);
+    }
+    CHECK(dma_alloc(DMA_PAGE_SIZE, dma_region::dtcm) == buffers[num - 1]);
+}
+
+void test_buffer() {
+    dma_buffer buffer { 100 };
+    CHECK(buffer && buffer.size() == 128);
+    buffer.prepare_for_device(dma_direction::from_device);
+    buffer.prepare_for_cpu(dma_direction::from_device);
+
+    dma_buffer moved { std::move(buffer) };
+    CHECK(!buffer && buffer.size() == 0 && moved.size() == 128);
+
+    dma_buffer invalid { DMA_PAGE_SIZE + 1 };
+    CHECK(!invalid && invalid.size() == 0);
+}
+} // namespace
+
+int main() {
+    test_sizes();
+    test_reuse();
+    test_exhaustion();
+    test_buffer();
+
+    if (g_failures) {
+        std::printf("dma_buffer_test: %d checks failed\n", g_failures);
+        return 1;
+    }
+
+    std::puts("dma_buffer_test passed");
+    return 0;
+}